@@ -0,0 +1,229 @@
+/**
+ * @example{lineno} Benchmark.ino
+ * @copyright Stroud Water Research Center
+ * @license This example is published under the BSD-3 license.
+ *
+ * @brief On-target microbenchmarks for the library itself.
+ *
+ * Measures what the ChangeLog's timing work actually costs on *this* board, and
+ * prints the results as a machine-parsable table so optimization commits can be
+ * accepted or rejected on numbers instead of gut feel:
+ *
+ * - `rx_isr_edge`    - the execution time of one receive-interrupt service, per
+ *                      line edge (min/mean/max)
+ * - `tx_char`        - the duration of one blocking character write against the
+ *                      8333 us ten-bit ideal; the spread is the bit-clock jitter
+ * - `crc_calc`       - `calculateCRC()` over a full 75-character data response
+ * - `parse_bulk`     - `parseValues()` splitting a captured line in one pass
+ * - `parse_stream`   - the same values pulled one at a time with `parseFloat()`
+ * - `buffer_drain_64`- `read()`ing 64 buffered characters back out
+ *
+ * No second board, sensor, or wiring is needed.  Build with
+ * `-DSDI12_EXTERNAL_PCINT` so that begin() does not attach a pin interrupt; the
+ * sketch then drives the data pin as an output and calls
+ * `SDI12::handleInterrupt()` itself at each edge, bracketed with `micros()`.
+ * That is the same stimulus a pin-change interrupt delivers, minus the vectoring
+ * overhead, which is constant per core and not what the library controls.
+ *
+ * Every row is printed as
+ *
+ *     BENCH,<name>,<iterations>,<min_us>,<mean_us>,<max_us>
+ *
+ * after a `BOARD,...` line identifying the configuration.  On AVR boards
+ * `micros()` has 4-8 us granularity; the per-edge min/max are quantized to it
+ * but the mean averages it out.
+ */
+
+#include <SDI12.h>
+
+#ifndef SDI12_EXTERNAL_PCINT
+#error "Build this sketch with -DSDI12_EXTERNAL_PCINT (see the header comment)."
+#endif
+
+#ifndef SDI12_DATA_PIN
+#define SDI12_DATA_PIN 7
+#endif
+
+int8_t dataPin = SDI12_DATA_PIN; /*!< The pin of the SDI-12 data bus */
+
+/** Define the SDI-12 bus */
+SDI12 mySDI12(dataPin);
+
+/** The span of one bit at 1200 baud, and of one 10-bit character frame */
+static const uint32_t BIT_US   = 833;
+static const uint32_t FRAME_US = 8333;
+
+/** Min/mean/max accumulator for one benchmark */
+struct BenchStats {
+  uint32_t minUs;
+  uint32_t maxUs;
+  uint32_t sumUs;
+  uint32_t n;
+  void     reset() {
+    minUs = 0xFFFFFFFFUL;
+    maxUs = 0;
+    sumUs = 0;
+    n     = 0;
+  }
+  void record(uint32_t us) {
+    if (us < minUs) { minUs = us; }
+    if (us > maxUs) { maxUs = us; }
+    sumUs += us;
+    n++;
+  }
+};
+
+/** Print one table row: BENCH,<name>,<iterations>,<min_us>,<mean_us>,<max_us> */
+static void printRow(const __FlashStringHelper* name, const BenchStats& st) {
+  Serial.print(F("BENCH,"));
+  Serial.print(name);
+  Serial.print(',');
+  Serial.print(st.n);
+  Serial.print(',');
+  Serial.print(st.minUs);
+  Serial.print(',');
+  Serial.print(st.n ? static_cast<float>(st.sumUs) / st.n : 0.0f, 2);
+  Serial.print(',');
+  Serial.println(st.maxUs);
+}
+
+/**
+ * @brief Drive one 7E1 character frame onto the data pin, calling the receive
+ * interrupt at each edge and (optionally) timing each call.
+ *
+ * The frame is built here, independently of the library's own transmitter, with
+ * the line convention HIGH = spacing = 0 and LOW = marking = 1: a HIGH start
+ * bit, seven data bits LSB first, an even parity bit, and a LOW stop bit.
+ */
+static void feedChar(uint8_t c, BenchStats* isrStats) {
+  uint8_t par = c;  // even parity over the seven data bits
+  par ^= par >> 4;
+  par ^= par >> 2;
+  par ^= par >> 1;
+  uint8_t level[10];
+  level[0] = HIGH;  // start bit = spacing
+  for (uint8_t i = 0; i < 7; i++) { level[1 + i] = ((c >> i) & 0x01) ? LOW : HIGH; }
+  level[8] = (par & 0x01) ? LOW : HIGH;
+  level[9] = LOW;  // stop bit = marking
+  uint8_t prev = LOW;
+  for (uint8_t slot = 0; slot < 10; slot++) {
+    if (level[slot] != prev) {
+      digitalWrite(dataPin, level[slot]);
+      if (isrStats) {
+        uint32_t t0 = micros();
+        SDI12::handleInterrupt();
+        isrStats->record(micros() - t0);
+      } else {
+        SDI12::handleInterrupt();
+      }
+      prev = level[slot];
+    }
+    delayMicroseconds(BIT_US);
+  }
+}
+
+/** Feed a whole string of frames (timing is per edge, not per string) */
+static void feedString(const char* s, BenchStats* isrStats) {
+  while (*s) { feedChar(static_cast<uint8_t>(*s++), isrStats); }
+}
+
+/** Put the bus in the listening state but keep the pin under the sketch's
+ * control so frames can be fed without a second board */
+static void listenAndDrive() {
+  mySDI12.forceListen();
+  pinMode(dataPin, OUTPUT);
+  digitalWrite(dataPin, LOW);  // idle = marking
+}
+
+static BenchStats stats;
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial && millis() < 10000L) {}
+
+  mySDI12.begin();
+  delay(100);
+
+  Serial.print(F("BOARD,F_CPU="));
+  Serial.print(F_CPU);
+  Serial.print(F(",TICKS_PER_SECOND="));
+  Serial.print(static_cast<uint32_t>(TICKS_PER_SECOND));
+  Serial.print(F(",RX_WINDOW_FUDGE="));
+  Serial.println(static_cast<uint32_t>(RX_WINDOW_FUDGE));
+  Serial.println(F("# BENCH,name,iterations,min_us,mean_us,max_us"));
+
+  // --- rx_isr_edge: the receive interrupt's own execution time, per edge ------
+  listenAndDrive();
+  stats.reset();
+  for (uint8_t rep = 0; rep < 20; rep++) {
+    feedString("0+1.2345-6.7890+8.901\r\n", &stats);
+    mySDI12.clearBuffer();
+  }
+  printRow(F("rx_isr_edge"), stats);
+
+  // --- tx_char: one blocking character write vs the 8333 us ideal -------------
+  // write() frames the character, clocks out the bits, and restores listening;
+  // the spread of these samples is the transmitter's bit-clock jitter
+  stats.reset();
+  for (uint8_t rep = 0; rep < 50; rep++) {
+    uint32_t t0 = micros();
+    mySDI12.write('x');
+    stats.record(micros() - t0);
+  }
+  printRow(F("tx_char"), stats);
+  Serial.print(F("# tx_char ideal is "));
+  Serial.print(FRAME_US);
+  Serial.println(F(" us; mean - ideal = framing overhead, max - min = jitter"));
+
+  // --- crc_calc: the CRC of a maximum-length (75 character) data response -----
+  String crcLine;
+  crcLine.reserve(75);
+  crcLine = "0";
+  while (crcLine.length() < 75) { crcLine += "+1.2345-6.7890"; }
+  stats.reset();
+  for (uint8_t rep = 0; rep < 100; rep++) {
+    uint32_t t0 = micros();
+    mySDI12.calculateCRC(crcLine);
+    stats.record(micros() - t0);
+  }
+  printRow(F("crc_calc"), stats);
+
+  // --- parse_bulk vs parse_stream: one-pass split vs per-value parseFloat -----
+  const char* line = "0+1.25-3.50+7.125+12.0-0.875";
+  float       out[8];
+  stats.reset();
+  for (uint8_t rep = 0; rep < 100; rep++) {
+    uint32_t t0 = micros();
+    mySDI12.parseValues(line, out, 8);
+    stats.record(micros() - t0);
+  }
+  printRow(F("parse_bulk"), stats);
+
+  mySDI12.setTimeout(5);  // the last parseFloat must not wait out a long timeout
+  stats.reset();
+  for (uint8_t rep = 0; rep < 20; rep++) {
+    listenAndDrive();
+    feedString(line, NULL);  // refill costs real line time, so few repetitions
+    feedString("\r\n", NULL);
+    uint32_t t0 = micros();
+    for (uint8_t v = 0; v < 5; v++) { out[v] = mySDI12.parseFloat(); }
+    stats.record(micros() - t0);
+    mySDI12.clearBuffer();
+  }
+  printRow(F("parse_stream"), stats);
+
+  // --- buffer_drain_64: pulling 64 buffered characters back out ---------------
+  stats.reset();
+  for (uint8_t rep = 0; rep < 10; rep++) {
+    listenAndDrive();
+    for (uint8_t i = 0; i < 64; i++) { feedChar('0' + (i & 0x07), NULL); }
+    uint32_t t0 = micros();
+    while (mySDI12.available()) { mySDI12.read(); }
+    stats.record(micros() - t0);
+  }
+  printRow(F("buffer_drain_64"), stats);
+
+  Serial.println(F("# done"));
+}
+
+void loop() {}
@@ -56,24 +56,69 @@
 SDI12* SDI12::_activeObject = nullptr;
 // Timer functions
 SDI12Timer SDI12::sdi12timer;
-
-/* ================ Buffer Setup ====================================================*/
-uint8_t          SDI12::_rxBuffer[SDI12_BUFFER_SIZE];  // The Rx buffer
-volatile uint8_t SDI12::_rxBufferTail = 0;             // index of buff tail
-volatile uint8_t SDI12::_rxBufferHead = 0;             // index of buff head
+// The dispatch table of instances currently listening for characters
+SDI12* SDI12::_listeners[SDI12_MAX_BUSES] = {nullptr};
 
 /* ================ Reading from the SDI-12 Buffer ==================================*/
 
+#if defined(SDI12_USE_RTOS)
+// Blocks the calling task on an interrupt-posted notification instead of a blind
+// delay; the buffer is re-checked after the task handle is published so a character
+// completing in the gap cannot be missed (the notification latches regardless).
+bool SDI12::waitForChar(uint16_t timeoutMs) {
+  if (_rxBufferHead != _rxBufferTail) { return true; }
+  _notifyTask = SDI12_RTOS_CURRENT_TASK();
+  bool notified = false;
+  if (_rxBufferHead != _rxBufferTail) {
+    notified = true;
+  } else {
+    notified = SDI12_RTOS_WAIT(timeoutMs);
+  }
+  _notifyTask = nullptr;
+  return notified || _rxBufferHead != _rxBufferTail;
+}
+
+bool SDI12::waitForMessage(uint16_t timeoutMs) {
+  uint32_t start = millis();
+  _notifyTask    = SDI12_RTOS_CURRENT_TASK();
+  // every completed character notifies; keep waiting until the end-of-response flag
+  // rises or the deadline passes
+  while (!_messageComplete) {
+    uint32_t elapsed = millis() - start;
+    if (elapsed >= timeoutMs) { break; }
+    if (!SDI12_RTOS_WAIT(timeoutMs - elapsed)) { break; }
+  }
+  _notifyTask = nullptr;
+  return _messageComplete;
+}
+#endif  // SDI12_USE_RTOS
+
 // reveals the number of characters available in the buffer
 int SDI12::available() {
+  if (_phy) return _phy->available();
+#if defined(SDI12_USE_RTOS)
+  waitForChar();  // sleep out a mid-flight character instead of a blind delay
+#else
   SDI12_YIELD()
+#endif
+#ifdef SDI12_MINIMAL_ISR
+  service();  // run the deferred character processing before answering
+#endif
   if (_bufferOverflow) return -1;
-  return (_rxBufferTail + SDI12_BUFFER_SIZE - _rxBufferHead) % SDI12_BUFFER_SIZE;
+  return (_rxBufferTail + SDI12_BUFFER_SIZE - _rxBufferHead) & (SDI12_BUFFER_SIZE - 1);
 }
 
 // reveals the next character in the buffer without consuming
 int SDI12::peek() {
+  if (_phy) return _phy->peek();
+#if defined(SDI12_USE_RTOS)
+  waitForChar();
+#else
   SDI12_YIELD()
+#endif
+#ifdef SDI12_MINIMAL_ISR
+  service();  // run the deferred character processing before answering
+#endif
   if (_rxBufferHead == _rxBufferTail) return -1;  // Empty buffer? If yes, -1
   return _rxBuffer[_rxBufferHead];                // Otherwise, read from "head"
 }
@@ -81,19 +126,239 @@ int SDI12::peek() {
 // a public function that clears the buffer contents and resets the status of the buffer
 // overflow.
 void SDI12::clearBuffer() {
-  _rxBufferHead   = 0;
-  _rxBufferTail   = 0;
-  _bufferOverflow = false;
+  if (_phy) {
+    while (_phy->read() >= 0) {}  // drain the backend's receive buffer
+    return;
+  }
+  _rxBufferHead    = 0;
+  _rxBufferTail    = 0;
+  _bufferOverflow  = false;
+  _messageComplete = false;
+#ifdef SDI12_LINE_QUEUE
+  noInterrupts();  // the queue state is shared with the receive interrupt
+  _lineCount    = 0;
+  _lineReadSlot = _lineWriteSlot;
+  _lineFillLen  = 0;
+  _lineDropping = false;
+  interrupts();
+#endif
 }
 
 // reads in the next character from the buffer (and moves the index ahead)
 int SDI12::read() {
+  if (_phy) return _phy->read();
+#if defined(SDI12_USE_RTOS)
+  waitForChar();
+#else
   SDI12_YIELD()
+#endif
+#ifdef SDI12_MINIMAL_ISR
+  service();  // run the deferred character processing before answering
+#endif
   _bufferOverflow = false;                        // Reading makes room in the buffer
   if (_rxBufferHead == _rxBufferTail) return -1;  // Empty buffer? If yes, -1
-  uint8_t nextChar = _rxBuffer[_rxBufferHead];    // Otherwise, grab char at head
-  _rxBufferHead    = (_rxBufferHead + 1) % SDI12_BUFFER_SIZE;  // increment head
-  return nextChar;                                             // return the char
+  uint8_t nextChar = _rxBuffer[_rxBufferHead];  // Otherwise, grab char at head
+  _rxBufferHead = (_rxBufferHead + 1) & (SDI12_BUFFER_SIZE - 1);  // increment head
+  return nextChar;                                                // return the char
+}
+
+// drains up to n already-buffered characters in at most two memcpy()s - one
+// contiguous ring segment, or two when the data wraps
+size_t SDI12::readBytes(uint8_t* dst, size_t n) {
+  if (_phy) {  // the backend hides its buffer; fall back to per-character reads
+    size_t got = 0;
+    while (got < n) {
+      int c = _phy->read();
+      if (c < 0) { break; }
+      dst[got++] = static_cast<uint8_t>(c);
+    }
+    return got;
+  }
+#ifdef SDI12_MINIMAL_ISR
+  service();  // run the deferred character processing before answering
+#endif
+  // one volatile read of the tail; the receive interrupt only ever appends, so the
+  // snapshot can only understate what is available
+  uint8_t tail  = _rxBufferTail;
+  size_t  avail = (tail + SDI12_BUFFER_SIZE - _rxBufferHead) & (SDI12_BUFFER_SIZE - 1);
+  if (n > avail) { n = avail; }
+  if (n == 0) { return 0; }
+  size_t firstSeg = SDI12_BUFFER_SIZE - _rxBufferHead;  // up to the wrap point
+  if (firstSeg > n) { firstSeg = n; }
+  memcpy(dst, &_rxBuffer[_rxBufferHead], firstSeg);
+  if (n > firstSeg) { memcpy(dst + firstSeg, &_rxBuffer[0], n - firstSeg); }
+  _rxBufferHead   = (_rxBufferHead + n) & (SDI12_BUFFER_SIZE - 1);
+  _bufferOverflow = false;  // reading makes room in the buffer
+  return n;
+}
+
+// exposes the oldest contiguous run of buffered characters in place; nothing is
+// consumed until skipBytes()
+size_t SDI12::peekContiguous(const uint8_t** ptr) {
+  if (_phy) {  // the backend's buffer is not addressable
+    *ptr = nullptr;
+    return 0;
+  }
+#ifdef SDI12_MINIMAL_ISR
+  service();  // run the deferred character processing before answering
+#endif
+  uint8_t tail = _rxBufferTail;
+  if (tail == _rxBufferHead) {
+    *ptr = nullptr;
+    return 0;
+  }
+  *ptr = &_rxBuffer[_rxBufferHead];
+  if (tail > _rxBufferHead) { return tail - _rxBufferHead; }
+  return SDI12_BUFFER_SIZE - _rxBufferHead;  // the run ends at the wrap point
+}
+
+// the consuming half of a zero-copy peekContiguous() pass
+size_t SDI12::skipBytes(size_t n) {
+  if (_phy) {
+    size_t skipped = 0;
+    while (skipped < n && _phy->read() >= 0) { skipped++; }
+    return skipped;
+  }
+  uint8_t tail  = _rxBufferTail;
+  size_t  avail = (tail + SDI12_BUFFER_SIZE - _rxBufferHead) & (SDI12_BUFFER_SIZE - 1);
+  if (n > avail) { n = avail; }
+  _rxBufferHead   = (_rxBufferHead + n) & (SDI12_BUFFER_SIZE - 1);
+  _bufferOverflow = false;  // reading makes room in the buffer
+  return n;
+}
+
+#ifdef SDI12_LINE_STATS
+// Copies the statistics block with interrupts suspended so the snapshot is consistent.
+SDI12LineStats SDI12::getLineStats() {
+  SDI12LineStats snapshot;
+  noInterrupts();
+  snapshot.edgesSeen        = _lineStats.edgesSeen;
+  snapshot.charsCompleted   = _lineStats.charsCompleted;
+  snapshot.parityFailures   = _lineStats.parityFailures;
+  snapshot.framingAnomalies = _lineStats.framingAnomalies;
+  snapshot.bufferOverflows  = _lineStats.bufferOverflows;
+  snapshot.glitchesRejected = _lineStats.glitchesRejected;
+  snapshot.minIsrTicks      = _lineStats.minIsrTicks;
+  snapshot.maxIsrTicks      = _lineStats.maxIsrTicks;
+  interrupts();
+  return snapshot;
+}
+
+void SDI12::clearLineStats() {
+  noInterrupts();
+  _lineStats.edgesSeen        = 0;
+  _lineStats.charsCompleted   = 0;
+  _lineStats.parityFailures   = 0;
+  _lineStats.framingAnomalies = 0;
+  _lineStats.bufferOverflows  = 0;
+  _lineStats.glitchesRejected = 0;
+  // start the minimum at the timer type's maximum so the first interrupt sets it
+  _lineStats.minIsrTicks = static_cast<sdi12timer_t>(-1);
+  _lineStats.maxIsrTicks = 0;
+  interrupts();
+}
+#endif  // SDI12_LINE_STATS
+
+#ifdef SDI12_LINE_EVENTS
+// hands over - and clears - the line-event bits accumulated by the receive interrupt
+uint8_t SDI12::pollLineEvents() {
+  noInterrupts();
+  uint8_t events  = _lineEventFlags;
+  _lineEventFlags = 0;
+  interrupts();
+  return events;
+}
+
+uint32_t SDI12::lastBreakTime() {
+  noInterrupts();
+  uint32_t stamp = _breakMillis;
+  interrupts();
+  return stamp;
+}
+
+uint32_t SDI12::lastMarkingTime() {
+  noInterrupts();
+  uint32_t stamp = _markingMillis;
+  interrupts();
+  return stamp;
+}
+
+// the live poll for the idle condition; the SDI12_LINE_EVENT_IDLE flag can only be
+// raised retroactively, by the next edge
+bool SDI12::lineIdle() {
+  noInterrupts();
+  uint32_t lastEdge = _lastEdgeMillis;
+  interrupts();
+  return millis() - lastEdge > SDI12_LINE_IDLE_MS;
+}
+
+void SDI12::setLineEventHandler(SDI12LineEventHandler handler) {
+  _lineEventHandler = handler;
+}
+#endif  // SDI12_LINE_EVENTS
+
+// reveals whether a complete <CR><LF>-terminated response has arrived
+bool SDI12::messageAvailable() {
+  return _messageComplete;
+}
+
+// sets the user callback fired from the receive interrupt at end-of-response
+void SDI12::onReceive(SDI12Handler handler) {
+  _receiveHandler = handler;
+}
+
+#ifdef SDI12_LINE_QUEUE
+uint8_t SDI12::linesAvailable() {
+  return _lineCount;
+}
+
+// hands over the oldest published line by pointer - no copying, and no
+// per-character head/tail index traffic like the Stream read path
+const char* SDI12::readLine(uint8_t* len) {
+  if (_lineCount == 0) { return nullptr; }
+  uint8_t slot = _lineReadSlot;
+  if (len) { *len = _lineSlotLens[slot]; }
+  _lineReadSlot = (slot + 1) % SDI12_LINE_QUEUE_SLOTS;
+  noInterrupts();  // the count is also incremented from the receive interrupt
+  _lineCount--;
+  interrupts();
+  return _lineSlots[slot];
+}
+
+uint8_t SDI12::linesDropped(bool clear) {
+  uint8_t dropped = _linesDropped;
+  if (clear) { _linesDropped = 0; }
+  return dropped;
+}
+#endif  // SDI12_LINE_QUEUE
+
+// These hide the Stream versions, which wait out the blanket stream timeout; the
+// waits here are bounded by the two-tier response deadlines instead.  The applicable
+// deadline is the response-start deadline until the ISR sees the first character of a
+// response, and the much shorter inter-character deadline afterwards.
+int SDI12::timedRead() {
+  uint32_t startMillis = millis();
+  do {
+    int c = read();
+    if (c >= 0) return c;
+  } while (millis() - startMillis <
+           (_responseStarted ? _charTimeout : _startTimeout));
+  return -1;  // the applicable deadline passed without a character
+}
+
+int SDI12::timedPeek() {
+  uint32_t startMillis = millis();
+  do {
+    int c = peek();
+    if (c >= 0) return c;
+  } while (millis() - startMillis <
+           (_responseStarted ? _charTimeout : _startTimeout));
+  return -1;  // the applicable deadline passed without a character
+}
+
+void SDI12::setResponseTimeouts(uint16_t startTimeoutMs, uint16_t charTimeoutMs) {
+  _startTimeout = startTimeoutMs;
+  _charTimeout  = charTimeoutMs;
 }
 
 // these functions HIDE the stream equivalents to return a custom timeout value
@@ -180,6 +445,9 @@ SDI12::SDI12() {
   // to be -9999, which is not a common value for most variables measured by
   // in-site environmental sensors.
   setTimeoutValue(-9999);
+#ifdef SDI12_LINE_STATS
+  clearLineStats();
+#endif
 }
 
 SDI12::SDI12(int8_t dataPin) {
@@ -194,6 +462,9 @@ SDI12::SDI12(int8_t dataPin) {
   // to be -9999, which is not a common value for most variables measured by
   // in-site environmental sensors.
   setTimeoutValue(-9999);
+#ifdef SDI12_LINE_STATS
+  clearLineStats();
+#endif
 }
 
 // Destructor
@@ -203,6 +474,12 @@ SDI12::~SDI12() {
 
 // Begin
 void SDI12::begin() {
+  if (_phy) {
+    // The backend owns the data line; no pin interrupts or timers are needed here.
+    _phy->begin(_dataPin);
+    _activeObject = this;
+    return;
+  }
 #if defined(ESP32) || defined(ESP8266)
   // Add and remove a fake interrupt to avoid errors with gpio_install_isr_service
   attachInterrupt(digitalPinToInterrupt(_dataPin), nullptr, CHANGE);
@@ -222,7 +499,13 @@ void SDI12::begin(int8_t dataPin) {
 
 // End
 void SDI12::end() {
+  if (_phy) {
+    _phy->end();
+    if (isActive()) { _activeObject = nullptr; }
+    return;
+  }
   setState(SDI12_DISABLED);
+  _busWoken = false;  // assume the sensors fall asleep while the object is disabled
   if (isActive()) { _activeObject = nullptr; }
   // Set the timer prescalers back to original values
   sdi12timer.resetSDI12TimerPrescale();
@@ -243,6 +526,11 @@ int8_t SDI12::getDataPin() {
   return _dataPin;
 }
 
+// Attach (or detach) a physical-layer backend; must be done before begin()
+void SDI12::setPhyBackend(SDI12Phy* phy) {
+  _phy = phy;
+}
+
 /* ================ Using more than one SDI-12 object ===============================*/
 // a method for setting the current object as the active object
 bool SDI12::setActive() {
@@ -259,6 +547,25 @@ bool SDI12::isActive() {
   return this == _activeObject;
 }
 
+// Enters an instance into the listener dispatch table so the shared interrupt
+// handler will route its pin's edges to it.
+void SDI12::addListener(SDI12* obj) {
+  removeListener(obj);  // never list the same instance twice
+  for (uint8_t i = 0; i < SDI12_MAX_BUSES; i++) {
+    if (_listeners[i] == nullptr) {
+      obj->_lastPinLevel = LOW;  // the line is at marking when listening starts
+      _listeners[i]      = obj;
+      return;
+    }
+  }
+}
+
+void SDI12::removeListener(SDI12* obj) {
+  for (uint8_t i = 0; i < SDI12_MAX_BUSES; i++) {
+    if (_listeners[i] == obj) { _listeners[i] = nullptr; }
+  }
+}
+
 /* ================ Data Line States ================================================*/
 // Processor specific parity and interrupts
 #if defined __AVR__
@@ -279,7 +586,22 @@ uint8_t SDI12::parity_even_bit(uint8_t v) {
 
 // a helper function to switch pin interrupts on or off
 void SDI12::setPinInterrupts(bool enable) {
-#if defined(__AVR__) && not defined(SDI12_EXTERNAL_PCINT)
+  // Keep the listener dispatch table in step with the pin interrupts, so the shared
+  // interrupt handler knows which instances' pins to check.
+  if (enable) {
+    addListener(this);
+  } else {
+    removeListener(this);
+  }
+#if defined(__AVR__) && defined(SDI12_USE_INPUT_CAPTURE)
+  if (enable) {
+    TCCR1B |= (1 << ICES1);  // capture the rising edge of the start bit first
+    TIFR1 = (1 << ICF1);     // clear any stale capture flag (write 1 to clear)
+    TIMSK1 |= (1 << ICIE1);  // enable the input capture interrupt
+  } else {
+    TIMSK1 &= ~(1 << ICIE1);  // disable the input capture interrupt
+  }
+#elif defined(__AVR__) && not defined(SDI12_EXTERNAL_PCINT)
   if (enable) {
     // Enable interrupts on the register with the pin of interest
     *digitalPinToPCICR(_dataPin) |= (1 << digitalPinToPCICRbit(_dataPin));
@@ -379,6 +701,22 @@ void SDI12::forceListen() {
 // ms of marking
 void SDI12::wakeSensors(int8_t extraWakeTime) {
   setState(SDI12_TRANSMITTING);
+  _messageComplete = false;  // a new exchange is starting
+  _responseStarted = false;
+#if SDI12_AWAKE_WINDOW_MS > 0
+  if (_busWoken && millis() - _lastLineActivity < SDI12_AWAKE_WINDOW_MS) {
+    // The sensors are provably still awake from the last exchange, so the break (and
+    // any extra wake delay) would be redundant.  The line has been marking since the
+    // last activity; only top up to the required 8.33 ms of marking if the previous
+    // exchange ended less than a marking period ago.
+    uint32_t markedMs = millis() - _lastLineActivity;
+    if (markedMs < (SDI12_LINE_MARK_MICROS / 1000 + 1)) {
+      delayMicroseconds(SDI12_LINE_MARK_MICROS -
+                        static_cast<uint16_t>(markedMs * 1000));
+    }
+    return;
+  }
+#endif
   // Universal interrupts can be on while the break and marking happen because
   // timings for break and from the recorder are not critical.
   // Interrupts on the pin are disabled for the entire transmitting state
@@ -393,9 +731,13 @@ void SDI12::wakeSensors(int8_t extraWakeTime) {
 
 // this function writes a character out on the data line
 void SDI12::writeChar(uint8_t outChar) {
-  uint8_t currentTxBitNum = 0;  // first bit is start bit
-  uint8_t bitValue        = 1;  // start bit is HIGH (inverse parity...)
+  // Frame the character - parity, inverse logic, start and stop bits - before the
+  // line is touched, so none of that work lands inside the interrupts-off window.
+  writeFrame(buildFrame(outChar));
+}
 
+// this function clocks a pre-computed 10-bit frame out on the data line
+void SDI12::writeFrame(uint16_t frame) {
   // The tolerance on all SDI-12 commands is 0.40ms = 400µs. But... that's for between
   // commands, and we don't know how accurate all sensors are, so we probably don't want
   // to be off by more than 1/10 of that between bits.
@@ -414,64 +756,38 @@ void SDI12::writeChar(uint8_t outChar) {
   // functions like micros(), millis() and any real-time clocks, so we don't want to
   // disable them if we don't really have to.
 
+  // Find the position of the last bit slot driven HIGH (ie, HIGH, not marking).  That
+  // bit is the last time-critical one: every bit after it is LOW, which is identical
+  // to marking, so the trailing span can be timed out with interrupts enabled.  In a
+  // frame a 1 means HIGH, so this is just the index of the most significant set bit -
+  // a single count-leading-zeros instruction on most cores.  The start bit (bit 0) is
+  // always set, so the frame is never zero.
+  uint8_t lastHighBit = static_cast<uint8_t>((sizeof(unsigned int) * 8 - 1) -
+                                             __builtin_clz(frame));
+
 #if F_CPU < 48000000UL
   noInterrupts();  // _ALL_ interrupts disabled
 #endif
 
   sdi12timer_t t0 = READTIME;  // start time
 
-  digitalWrite(
-    _dataPin,
-    HIGH);  // immediately get going on the start bit
-            // this gives us 833µs to calculate parity and position of last high bit
-  currentTxBitNum++;
-
-  // Calculate parity, while writing the start bit
-  // This takes about 24 clock cycles on an AVR board (at 8MHz, that's 3µsec)
-
-  uint8_t parityBit = parity_even_bit(outChar);  // Calculate the parity bit
-  outChar |= (parityBit << 7);  // Add parity bit to the outgoing character
-
-  // Calculate the position of the last bit that is a 0/HIGH (ie, HIGH, not marking)
-  // That bit will be the last time-critical bit.  All bits after that can be
-  // sent with interrupts enabled.
-  // This calculation should also finish while writing the start bit
-  // This takes at least 10+13 clock cycles, and up to 10+(13*9)= 127 clock cycles (at
-  // 8MHz, that's 15.875µsec)
+  digitalWrite(_dataPin, HIGH);  // immediately get going on the start bit
 
-  uint8_t lastHighBit =
-    9;  // The position of the last bit that is a 0 (ie, HIGH, not marking)
-  uint8_t msbMask = 0x80;  // A mask with all bits at 1
-  while (msbMask & outChar) {
-    lastHighBit--;
-    msbMask >>= 1;
+  // clock out the bits up to and including the last HIGH one
+  for (uint8_t bit = 1; bit <= lastHighBit; bit++) {
+    // Hold the line for the previous bit's duration
+    while (static_cast<sdi12timer_t>(READTIME - t0) <
+           static_cast<sdi12timer_t>(TICKS_PER_BIT)) {}
+    t0 = READTIME;  // advance start time
+    digitalWrite(_dataPin, (frame >> bit) & 0x01 ? HIGH : LOW);
   }
 
-  // Hold the line for the rest of the start bit duration
-  // We've used up roughly 150 clock cycles messing with parity, but a bit is 833µs, so
-  // we've got time.
-
+  // Hold the line for the last HIGH bit's duration
   while (static_cast<sdi12timer_t>(READTIME - t0) <
          static_cast<sdi12timer_t>(TICKS_PER_BIT)) {}
   t0 = READTIME;  // advance start time
 
-  // repeat for all data bits until the last bit different from marking
-  while (currentTxBitNum++ < lastHighBit) {
-    bitValue = outChar & 0x01;  // get next bit in the character to send
-    if (bitValue) {
-      digitalWrite(_dataPin, LOW);  // set the pin state to LOW for 1's
-    } else {
-      digitalWrite(_dataPin, HIGH);  // set the pin state to HIGH for 0's
-    }
-    // Hold the line for this bit duration
-    while (static_cast<sdi12timer_t>(READTIME - t0) <
-           static_cast<sdi12timer_t>(TICKS_PER_BIT)) {}
-    t0 = READTIME;  // advance start time
-
-    outChar = outChar >> 1;  // shift character to expose the following bit
-  }
-
-  // Set the line low for the all remaining 1's and the stop bit
+  // Set the line low for all the remaining 1's and the stop bit
   digitalWrite(_dataPin, LOW);
 
 #if F_CPU < 48000000UL
@@ -480,7 +796,7 @@ void SDI12::writeChar(uint8_t outChar) {
 
   // Hold the line low until the end of the 10th bit
   sdi12timer_t bitTimeRemaining = static_cast<sdi12timer_t>(TICKS_PER_BIT) *
-    (10 - lastHighBit);
+    (9 - lastHighBit);
   while (static_cast<sdi12timer_t>(READTIME - t0) < bitTimeRemaining) {}
 }
 
@@ -488,34 +804,317 @@ void SDI12::writeChar(uint8_t outChar) {
 // This allows you to use the stream print functions to send commands out on
 // the SDI-12, line, but it will not wake the sensors in advance of the command.
 size_t SDI12::write(uint8_t byte) {
+#if defined(SDI12_TIMER_COMPARE)
+  if (!_phy) {
+    uint16_t frame = buildFrame(byte);  // frame it before touching shared state
+    // wait for a free slot; the bit clock frees one every ~8.33 ms
+    while (_txFrameCount >= SDI12_TX_BUFFER_SIZE) {}
+    noInterrupts();  // the bit-clock interrupt consumes these variables
+    _txFrames[_txWriteIndex] = frame;
+    if (++_txWriteIndex >= SDI12_TX_BUFFER_SIZE) { _txWriteIndex = 0; }
+    _txFrameCount++;
+    if (_txPhase == SDI12_TX_IDLE) {
+      // start the bit clock directly in the data phase: write() sends raw
+      // characters, so no break or wake marking (that is sendCommand()'s job).
+      // While the producer keeps the queue fed, characters stream back-to-back
+      // with the line held at marking between them.
+      setState(SDI12_TRANSMITTING);
+      _txBitIndex = 0;
+      _txPhase    = SDI12_TX_DATA;
+      sdi12timer.startBitInterrupt();
+    }
+    interrupts();
+    return 1;  // 1 character queued
+  }
+#endif
+  // no bit clock (or a hardware backend): send the character blocking
   setState(SDI12_TRANSMITTING);
   writeChar(byte);            // write the character/byte
   setState(SDI12_LISTENING);  // listen for reply
   return 1;                   // 1 character sent
 }
 
+int SDI12::availableForWrite() {
+#if defined(SDI12_TIMER_COMPARE)
+  if (!_phy) { return SDI12_TX_BUFFER_SIZE - _txFrameCount; }
+#endif
+  return 1;  // no queue, but a blocking write() is always accepted
+}
+
+void SDI12::flush() {
+#if defined(SDI12_TIMER_COMPARE)
+  while (isTransmitting()) {
+#if defined(SDI12_SLEEP_TX)
+    SDI12_TX_SLEEP();  // idle-sleep between bit interrupts instead of spinning
+#endif
+  }
+#endif
+}
+
 // this function sends out the characters of the String cmd, one by one
 void SDI12::sendCommand(String& cmd, int8_t extraWakeTime) {
   sendCommand(cmd.c_str(), extraWakeTime);
 }
 
 void SDI12::sendCommand(const char* cmd, int8_t extraWakeTime) {
+#if SDI12_WAKE_TABLE_SLOTS > 0
+  extraWakeTime = applyLearnedWakeTime(cmd[0], extraWakeTime);
+#endif
+  if (_phy) {
+    _phy->sendBreakAndCommand(cmd, strlen(cmd), extraWakeTime);
+    return;
+  }
+#if defined(SDI12_SLEEP_TX) && defined(SDI12_TIMER_COMPARE)
+  // Hand the whole transmission to the interrupt-driven bit clock and idle-sleep
+  // between edges instead of spinning through the break, marking, and bit waits at
+  // full active current.  Every interrupt wakes the sleep, so completion is
+  // re-checked at worst once per millis tick.  Note that the transmit-complete
+  // handler fires on this path, as it does for beginCommand().
+  if (beginCommand(cmd, extraWakeTime)) {
+    while (isTransmitting()) { SDI12_TX_SLEEP(); }
+    return;
+  }
+  // the command could not be queued (transmitter busy or command longer than
+  // SDI12_TX_BUFFER_SIZE); fall through to the blocking path
+#endif
+  // Pre-compute every character's frame into a stack array before touching the line,
+  // so nothing but the pin writes and the bit waits happens once sending starts.
+  // Commands longer than the frame buffer (non-standard) are sent in chunks.
+  size_t len = strlen(cmd);
+  size_t i   = 0;
   wakeSensors(extraWakeTime);  // wake up sensors
-  for (int unsigned i = 0; i < strlen(cmd); i++) {
-    writeChar(cmd[i]);  // write each character
+  while (i < len) {
+    uint16_t frames[SDI12_TX_BUFFER_SIZE];
+    uint8_t  n = 0;
+    while (n < SDI12_TX_BUFFER_SIZE && i < len) { frames[n++] = buildFrame(cmd[i++]); }
+    for (uint8_t j = 0; j < n; j++) { writeFrame(frames[j]); }
   }
+  _lastLineActivity = millis();  // the sensors stay awake for a while after this
+  _busWoken         = true;
   setState(SDI12_LISTENING);  // listen for reply
 }
 
 void SDI12::sendCommand(FlashString cmd, int8_t extraWakeTime) {
+#if SDI12_WAKE_TABLE_SLOTS > 0
+  extraWakeTime =
+    applyLearnedWakeTime(static_cast<char>(pgm_read_byte((PGM_P)cmd)), extraWakeTime);
+#endif
+  if (_phy) {
+    // commands are short; pull the flash string into RAM for the backend
+    char buf[SDI12_TX_BUFFER_SIZE + 1];
+    strncpy_P(buf, (PGM_P)cmd, SDI12_TX_BUFFER_SIZE);
+    buf[SDI12_TX_BUFFER_SIZE] = '\0';
+    _phy->sendBreakAndCommand(buf, strlen(buf), extraWakeTime);
+    return;
+  }
+#if defined(SDI12_SLEEP_TX) && defined(SDI12_TIMER_COMPARE)
+  // sleep through the interrupt-clocked transmission; see the char* overload
+  if (beginCommand(cmd, extraWakeTime)) {
+    while (isTransmitting()) { SDI12_TX_SLEEP(); }
+    return;
+  }
+#endif
+  // Pre-compute every character's frame - including the flash reads - before touching
+  // the line; see the char* overload.
+  size_t len = strlen_P((PGM_P)cmd);
+  size_t i   = 0;
   wakeSensors(extraWakeTime);  // wake up sensors
-  for (int unsigned i = 0; i < strlen_P((PGM_P)cmd); i++) {
-    // write each character
-    writeChar(static_cast<char>(pgm_read_byte((const char*)cmd + i)));
+  while (i < len) {
+    uint16_t frames[SDI12_TX_BUFFER_SIZE];
+    uint8_t  n = 0;
+    while (n < SDI12_TX_BUFFER_SIZE && i < len) {
+      frames[n++] = buildFrame(pgm_read_byte((const char*)cmd + i++));
+    }
+    for (uint8_t j = 0; j < n; j++) { writeFrame(frames[j]); }
   }
+  _lastLineActivity = millis();  // the sensors stay awake for a while after this
+  _busWoken         = true;
   setState(SDI12_LISTENING);  // listen for reply
 }
 
+// Pre-computes the 10 line levels for one outgoing character.
+// Bit 0 of the returned frame is the start bit and is clocked out first; a 1 in the
+// frame drives the line HIGH (spacing) for that bit slot.  Doing the inverse-logic
+// translation and parity calculation here keeps the bit-clock interrupt down to a
+// shift, a mask, and a digitalWrite.
+uint16_t SDI12::buildFrame(uint8_t outChar) {
+  uint8_t parityBit = parity_even_bit(outChar);  // Calculate the parity bit
+  uint8_t dataBits  = (outChar & 0x7F) |
+    (parityBit << 7);  // 7 data bits + the parity bit, LSB first
+  // start bit: HIGH (1); data+parity: inverted (0 bit -> HIGH); stop bit: LOW (0)
+  return static_cast<uint16_t>(0x0001 |
+                               ((static_cast<uint16_t>(~dataBits) & 0x00FF) << 1));
+}
+
+// this function begins sending the characters of the String cmd asynchronously
+bool SDI12::beginCommand(String& cmd, int8_t extraWakeTime) {
+  return beginCommand(cmd.c_str(), extraWakeTime);
+}
+
+bool SDI12::beginCommand(const char* cmd, int8_t extraWakeTime) {
+#if SDI12_WAKE_TABLE_SLOTS > 0
+  extraWakeTime = applyLearnedWakeTime(cmd[0], extraWakeTime);
+#endif
+  if (_phy) {
+    // hardware backends do their own (peripheral-driven) transmission
+    _phy->sendBreakAndCommand(cmd, strlen(cmd), extraWakeTime);
+    if (_txCompleteHandler) { _txCompleteHandler(); }
+    return true;
+  }
+#if defined(SDI12_TIMER_COMPARE)
+  if (_txPhase != SDI12_TX_IDLE) { return false; }  // already transmitting
+  size_t len = strlen(cmd);
+  if (len > SDI12_TX_BUFFER_SIZE) { return false; }  // command too long to queue
+  for (size_t i = 0; i < len; i++) {
+    _txFrames[i] = buildFrame(cmd[i]);  // pre-compute each character's frame
+  }
+  _txFrameCount = len;
+  _txFrameIndex = 0;
+  _txWriteIndex = len % SDI12_TX_BUFFER_SIZE;  // write() continues where these end
+  _txBitIndex   = 0;
+  setState(SDI12_TRANSMITTING);
+  _messageComplete = false;  // a new exchange is starting
+  _responseStarted = false;
+#if SDI12_AWAKE_WINDOW_MS > 0
+  if (_busWoken && millis() - _lastLineActivity < SDI12_AWAKE_WINDOW_MS) {
+    // Still within the awake window; skip straight to the marking phase
+    digitalWrite(_dataPin, LOW);  // continue the marking
+    _txPhaseBitsLeft = SDI12_TX_MARKING_BITS;
+    _txPhase         = SDI12_TX_MARKING;
+  } else {
+#endif
+    digitalWrite(_dataPin, HIGH);  // immediately start the break; break is HIGH
+    // The break lasts SDI12_TX_BREAK_BITS bit times plus ~1.2 bit times for each
+    // millisecond of extra wake time (1200 bits/second = 1.2 bits/ms, rounded up).
+    _txPhaseBitsLeft = static_cast<uint8_t>(
+      SDI12_TX_BREAK_BITS + (static_cast<uint16_t>(extraWakeTime) * 6 + 4) / 5);
+    _txPhase = SDI12_TX_BREAK;
+#if SDI12_AWAKE_WINDOW_MS > 0
+  }
+#endif
+  sdi12timer.startBitInterrupt();  // every bit from here on is interrupt-clocked
+  return true;
+#else
+  // Without a free timer compare channel there is no bit clock to drive the
+  // asynchronous transmitter, so fall back to the blocking send.
+  sendCommand(cmd, extraWakeTime);
+  if (_txCompleteHandler) { _txCompleteHandler(); }
+  return true;
+#endif
+}
+
+bool SDI12::beginCommand(FlashString cmd, int8_t extraWakeTime) {
+#if SDI12_WAKE_TABLE_SLOTS > 0
+  extraWakeTime =
+    applyLearnedWakeTime(static_cast<char>(pgm_read_byte((PGM_P)cmd)), extraWakeTime);
+#endif
+  if (_phy) {
+    sendCommand(cmd, extraWakeTime);  // delegates to the backend
+    if (_txCompleteHandler) { _txCompleteHandler(); }
+    return true;
+  }
+#if defined(SDI12_TIMER_COMPARE)
+  if (_txPhase != SDI12_TX_IDLE) { return false; }  // already transmitting
+  size_t len = strlen_P((PGM_P)cmd);
+  if (len > SDI12_TX_BUFFER_SIZE) { return false; }  // command too long to queue
+  for (size_t i = 0; i < len; i++) {
+    _txFrames[i] = buildFrame(pgm_read_byte((const char*)cmd + i));
+  }
+  _txFrameCount = len;
+  _txFrameIndex = 0;
+  _txWriteIndex = len % SDI12_TX_BUFFER_SIZE;  // write() continues where these end
+  _txBitIndex   = 0;
+  setState(SDI12_TRANSMITTING);
+  _messageComplete = false;  // a new exchange is starting
+  _responseStarted = false;
+#if SDI12_AWAKE_WINDOW_MS > 0
+  if (_busWoken && millis() - _lastLineActivity < SDI12_AWAKE_WINDOW_MS) {
+    // Still within the awake window; skip straight to the marking phase
+    digitalWrite(_dataPin, LOW);  // continue the marking
+    _txPhaseBitsLeft = SDI12_TX_MARKING_BITS;
+    _txPhase         = SDI12_TX_MARKING;
+  } else {
+#endif
+    digitalWrite(_dataPin, HIGH);  // immediately start the break; break is HIGH
+    _txPhaseBitsLeft = static_cast<uint8_t>(
+      SDI12_TX_BREAK_BITS + (static_cast<uint16_t>(extraWakeTime) * 6 + 4) / 5);
+    _txPhase = SDI12_TX_BREAK;
+#if SDI12_AWAKE_WINDOW_MS > 0
+  }
+#endif
+  sdi12timer.startBitInterrupt();  // every bit from here on is interrupt-clocked
+  return true;
+#else
+  sendCommand(cmd, extraWakeTime);
+  if (_txCompleteHandler) { _txCompleteHandler(); }
+  return true;
+#endif
+}
+
+bool SDI12::isTransmitting() {
+  return _txPhase != SDI12_TX_IDLE;
+}
+
+void SDI12::setTransmitCompleteHandler(SDI12Handler handler) {
+  _txCompleteHandler = handler;
+}
+
+// Finishes an asynchronous transmission: the stop bit of the last character has been
+// held for a full bit time, so the line can be handed back to the sensors.
+void SDI12::endTransmission() {
+#if defined(SDI12_TIMER_COMPARE)
+  sdi12timer.stopBitInterrupt();
+#endif
+  _txPhase          = SDI12_TX_IDLE;
+  _lastLineActivity = millis();  // the sensors stay awake for a while after this
+  _busWoken         = true;
+  setState(SDI12_LISTENING);  // listen for the reply
+  if (_txCompleteHandler) { _txCompleteHandler(); }
+}
+
+// Advances the asynchronous transmitter by one bit.  Called from the timer
+// compare-match interrupt once per bit time (833µs), so there is no spin-waiting
+// anywhere in the asynchronous transmit path.
+void ISR_MEM_ACCESS SDI12::txBitISR() {
+#if defined(SDI12_TIMER_COMPARE)
+  sdi12timer.nextBitInterrupt();  // re-arm for the next bit first - drift-free
+#endif
+  switch (_txPhase) {
+    case SDI12_TX_BREAK:
+      if (--_txPhaseBitsLeft == 0) {
+        digitalWrite(_dataPin, LOW);  // break is over; marking is LOW
+        _txPhase         = SDI12_TX_MARKING;
+        _txPhaseBitsLeft = SDI12_TX_MARKING_BITS;
+      }
+      break;
+    case SDI12_TX_MARKING:
+      if (--_txPhaseBitsLeft == 0) { _txPhase = SDI12_TX_DATA; }
+      break;
+    case SDI12_TX_DATA:
+      if (_txFrameCount == 0) {
+        // the final stop bit has now been held for a full bit time
+        endTransmission();
+        break;
+      }
+      digitalWrite(_dataPin,
+                   (_txFrames[_txFrameIndex] >> _txBitIndex) & 0x01 ? HIGH : LOW);
+      if (++_txBitIndex >= 10) {  // 10 bits per frame, then on to the next character
+        _txBitIndex = 0;
+        if (++_txFrameIndex >= SDI12_TX_BUFFER_SIZE) { _txFrameIndex = 0; }
+        _txFrameCount--;
+      }
+      break;
+    default:  // SDI12_TX_IDLE - spurious interrupt; make sure the bit clock is off
+      endTransmission();
+      break;
+  }
+}
+
+// Passes off responsibility for the compare-match interrupt to the active object.
+void ISR_MEM_ACCESS SDI12::handleTxBitInterrupt() {
+  if (_activeObject) _activeObject->txBitISR();
+}
+
 // This function sets up for a response to a separate data recorder by sending out a
 // marking and then sending out the characters of resp one by one (for slave-side use,
 // that is, when the Arduino itself is acting as an SDI-12 device rather than a
@@ -559,92 +1158,660 @@ void SDI12::sendResponse(FlashString resp, bool addCRC) {
   setState(SDI12_LISTENING);  // return to listening state
 }
 
+#ifdef SDI12_SLAVE
+
+void SDI12::setSlaveAddress(char address) {
+  _slaveAddress = address;
+  _slaveCmdLen  = 0;
+  _slaveBreak   = false;
+  _slavePending = -1;
+}
+
+char SDI12::getSlaveAddress() {
+  return _slaveAddress;
+}
+
+bool SDI12::registerResponse(const char* command, const char* response, bool addCRC) {
+  // re-registering a command replaces its entry
+  for (uint8_t i = 0; i < _slaveResponseCount; i++) {
+    if (strcmp(_slaveResponses[i].command, command) == 0) {
+      _slaveResponses[i].response = response;
+      _slaveResponses[i].addCRC   = addCRC;
+      return true;
+    }
+  }
+  if (_slaveResponseCount >= SDI12_SLAVE_MAX_RESPONSES) { return false; }
+  _slaveResponses[_slaveResponseCount].command  = command;
+  _slaveResponses[_slaveResponseCount].response = response;
+  _slaveResponses[_slaveResponseCount].addCRC   = addCRC;
+  _slaveResponseCount++;
+  return true;
+}
+
+void SDI12::clearResponses() {
+  _slaveResponseCount = 0;
+  _slavePending       = -1;
+}
+
+void SDI12::onCommand(SDI12CommandHandler handler) {
+  _commandHandler = handler;
+}
+
+bool SDI12::slaveBreakReceived(bool clear) {
+  bool wasBroken = _slaveBreak;
+  if (clear) { _slaveBreak = false; }
+  return wasBroken;
+}
+
+// Assembles inbound characters into a command.  Runs in the receive ISR, so by the
+// time the terminating `!` is decoded the command can be matched and the response
+// queued without waiting for the main loop to come around.
+void ISR_MEM_ACCESS SDI12::slaveHandleChar(uint8_t c) {
+  if (_slaveCmdLen >= SDI12_SLAVE_CMD_LEN) {
+    _slaveCmdLen = 0;  // overlong; discard and resynchronize on the next character
+  }
+  _slaveCmd[_slaveCmdLen++] = static_cast<char>(c);
+  if (c != '!') { return; }  // every SDI-12 command ends with `!`
+  _slaveCmd[_slaveCmdLen] = '\0';
+  if (_slaveCmd[0] == _slaveAddress || _slaveCmd[0] == '?') {
+    // match the part after the address against the response table
+    for (uint8_t i = 0; i < _slaveResponseCount; i++) {
+      if (strcmp(_slaveCmd + 1, _slaveResponses[i].command) == 0) {
+        if (!beginSlaveResponse(i)) {
+          _slavePending = static_cast<int8_t>(i);  // slaveService() sends it instead
+        }
+        _slaveCmdLen = 0;
+        return;
+      }
+    }
+    if (_commandHandler) { _commandHandler(_slaveCmd); }
+  }
+  _slaveCmdLen = 0;
+}
+
+bool ISR_MEM_ACCESS SDI12::beginSlaveResponse(uint8_t idx) {
+#if defined(SDI12_TIMER_COMPARE)
+  if (_txPhase != SDI12_TX_IDLE) { return false; }  // already transmitting
+  const SDI12SlaveResponse& entry   = _slaveResponses[idx];
+  size_t                    bodyLen = strlen(entry.response);
+  // address + body + optional CRC + <CR><LF> must fit in the frame buffer
+  if (1 + bodyLen + (entry.addCRC ? 3u : 0u) + 2 > SDI12_TX_BUFFER_SIZE) {
+    return false;
+  }
+  uint8_t  n   = 0;
+  uint16_t crc = crcInit();
+  _txFrames[n++] = buildFrame(_slaveAddress);
+  crc            = crcUpdate(crc, static_cast<uint8_t>(_slaveAddress));
+  for (size_t i = 0; i < bodyLen; i++) {
+    _txFrames[n++] = buildFrame(entry.response[i]);
+    crc            = crcUpdate(crc, static_cast<uint8_t>(entry.response[i]));
+  }
+  if (entry.addCRC) {
+    char crcChars[4] = {0};
+    crcToChars(crcFinalize(crc), crcChars);
+    for (uint8_t i = 0; i < 3; i++) { _txFrames[n++] = buildFrame(crcChars[i]); }
+  }
+  _txFrames[n++] = buildFrame('\r');
+  _txFrames[n++] = buildFrame('\n');
+  _txFrameCount  = n;
+  _txFrameIndex  = 0;
+  _txWriteIndex  = n % SDI12_TX_BUFFER_SIZE;  // write() continues where these end
+  _txBitIndex    = 0;
+  setState(SDI12_TRANSMITTING);
+  // No break - a slave response starts with the 8.33 ms marking alone
+  digitalWrite(_dataPin, LOW);  // marking is LOW
+  _txPhaseBitsLeft = SDI12_TX_MARKING_BITS;
+  _txPhase         = SDI12_TX_MARKING;
+  sdi12timer.startBitInterrupt();
+  return true;
+#else
+  (void)idx;
+  return false;  // no bit clock; slaveService() sends the response instead
+#endif
+}
+
+void SDI12::slaveService() {
+  if (_slavePending < 0) { return; }
+  noInterrupts();  // take the pending index atomically against the receive ISR
+  int8_t idx    = _slavePending;
+  _slavePending = -1;
+  interrupts();
+  if (idx < 0 || idx >= static_cast<int8_t>(_slaveResponseCount)) { return; }
+  const SDI12SlaveResponse& entry = _slaveResponses[idx];
+
+  // assemble the full line - address + body + optional CRC + <CR><LF>
+  char   line[SDI12_BUFFER_SIZE];
+  size_t n  = 0;
+  line[n++] = _slaveAddress;
+  for (const char* p = entry.response; *p != '\0' && n < sizeof(line) - 6; p++) {
+    line[n++] = *p;
+  }
+  if (entry.addCRC) {
+    line[n] = '\0';
+    crcToChars(calculateCRC(line), line + n);
+    n += 3;
+  }
+  line[n++] = '\r';
+  line[n++] = '\n';
+  line[n]   = '\0';
+  sendResponse(line, false);
+}
+
+#endif  // SDI12_SLAVE
+
 /**
- * @brief The polynomial to match the CRC with; set in the SDI-12 specifications
+ * @brief A 256-entry lookup table for the SDI-12 CRC polynomial, 0xA001.
+ *
+ * Each entry is the result of running the specification's 8-iteration bit loop on one
+ * input byte, so a character can be folded into the CRC with a single table lookup
+ * and shift instead of 8 conditional shift/XOR rounds.  The table is kept in flash
+ * (PROGMEM) and costs 512 bytes of program space; it is read with pgm_read_word(),
+ * which maps to a plain read on non-AVR boards.
  */
-#define POLY 0xa001
+static const uint16_t sdi12CRCTable[256] PROGMEM = {
+  0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+  0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+  0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+  0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+  0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+  0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+  0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+  0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+  0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+  0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+  0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+  0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+  0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+  0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+  0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+  0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+  0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+  0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+  0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+  0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+  0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+  0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+  0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+  0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+  0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+  0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+  0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+  0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+  0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+  0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+  0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+  0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040};
+
+uint16_t SDI12::crcInit() {
+  return 0x0000;  // the specification's initial CRC value
+}
+
+uint16_t SDI12::crcUpdate(uint16_t crc, uint8_t c) {
+  // one table lookup replaces the specification's 8-iteration bit loop
+  return (crc >> 8) ^ pgm_read_word(&sdi12CRCTable[(crc ^ c) & 0x00FF]);
+}
+
+uint16_t SDI12::crcFinalize(uint16_t crc) {
+  return crc;  // no final XOR or reflection for the SDI-12 CRC
+}
 
 uint16_t SDI12::calculateCRC(String& resp) {
   return calculateCRC(resp.c_str());
 }
 
 uint16_t SDI12::calculateCRC(const char* resp) {
-  uint16_t crc = 0;
-
+  uint16_t crc = crcInit();
   for (size_t i = 0; i < strlen(resp); i++) {
-    crc ^= static_cast<uint16_t>(
-      resp[i]);  // Set the CRC equal to the exclusive OR of the character and itself
-    for (int j = 0; j < 8; j++) {  // count = 1 to 8
-      if (crc & 0x0001) {          // if the least significant bit of the CRC is one
-        crc >>= 1;                 // right shift the CRC one bit
-        crc ^= POLY;  // set CRC equal to the exclusive OR of POLY and itself
-      } else {
-        crc >>= 1;  // right shift the CRC one bit
-      }
-    }
+    crc = crcUpdate(crc, static_cast<uint8_t>(resp[i]));
   }
-  return crc;
+  return crcFinalize(crc);
 }
 
 uint16_t SDI12::calculateCRC(FlashString resp) {
-  uint16_t crc = 0;
-  char     response_char;
-
+  uint16_t crc = crcInit();
   for (size_t i = 0; i < strlen_P((PGM_P)resp); i++) {
-    response_char = (char)pgm_read_byte((const char*)resp + i);
-    crc ^= static_cast<uint16_t>(response_char);  // Set the CRC equal to the exclusive
-                                                  // OR of the character and itself
-    for (int j = 0; j < 8; j++) {                 // count = 1 to 8
-      if (crc & 0x0001) {  // if the least significant bit of the CRC is one
-        crc >>= 1;         // right shift the CRC one bit
-        crc ^= POLY;       // set CRC equal to the exclusive OR of POLY and itself
-      } else {
-        crc >>= 1;  // right shift the CRC one bit
-      }
-    }
+    crc = crcUpdate(crc, pgm_read_byte((const char*)resp + i));
   }
-  return crc;
+  return crcFinalize(crc);
+}
+
+void SDI12::crcToChars(uint16_t crc, char* buf) {
+  buf[0] = (char)(0x0040 | (crc >> 12));
+  buf[1] = (char)(0x0040 | ((crc >> 6) & 0x003F));
+  buf[2] = (char)(0x0040 | (crc & 0x003F));
 }
 
 String SDI12::crcToString(uint16_t crc) {
-  char crcStr[3] = {0};
-  crcStr[0]      = (char)(0x0040 | (crc >> 12));
-  crcStr[1]      = (char)(0x0040 | ((crc >> 6) & 0x003F));
-  crcStr[2]      = (char)(0x0040 | (crc & 0x003F));
-  return (String(crcStr[0]) + String(crcStr[1]) + String(crcStr[2]));
+  char crcStr[4] = {0};
+  crcToChars(crc, crcStr);
+  return String(crcStr);
 }
 
 bool SDI12::verifyCRC(String& respWithCRC) {
   // trim trailing \r and \n (<CR> and <LF>)
   respWithCRC.trim();
   uint16_t nChar =
-    respWithCRC.length();  // number of characters without  (readable string composed of
-                           // sensor address, values separated by + and -) and the 3
-                           // characters of the CRC
-  String recCRC    = "";   // the CRC portion of the response
-  String recString = "";   // the data portion of the response
+    respWithCRC.length();  // number of characters of the readable string (composed of
+                           // sensor address and values separated by + and -) plus the
+                           // 3 characters of the CRC
+  if (nChar < 3) { return false; }
+
+  // calculate the CRC for the data portion - everything except the last 3 characters
+  uint16_t crc = crcInit();
+  for (uint16_t i = 0; i < (nChar - 3); i++) {
+    crc = crcUpdate(crc, static_cast<uint8_t>(respWithCRC[i]));
+  }
+  char calcCRC[3];
+  crcToChars(crcFinalize(crc), calcCRC);
 
-  // extract the data portion of the string
-  for (uint16_t i = 0; i < (nChar - 3); i++) recString += respWithCRC[i];
+  // compare with the last 3 characters, which are the received CRC
+  return calcCRC[0] == respWithCRC[nChar - 3] && calcCRC[1] == respWithCRC[nChar - 2] &&
+    calcCRC[2] == respWithCRC[nChar - 1];
+}
 
-  // extract the last 3 characters that are the CRC from the full response string
-  for (uint16_t i = (nChar - 3); i < nChar; i++) recCRC += respWithCRC[i];
+int16_t SDI12::readResponse(char* buf, size_t len, bool checkCRC, uint32_t timeout) {
+  if (len == 0) { return SDI12_READ_OVERFLOW; }
+  size_t   count    = 0;
+  uint16_t crc      = crcInit();
+  bool     complete = false;
+  bool     gotCR    = false;
+  uint32_t start    = millis();
+
+  // The overall timeout caps the whole response, but within it the two-tier
+  // deadlines fail fast: an absent sensor costs only the response-start deadline
+  // and a response that dies mid-message only the inter-character deadline.
+  uint32_t lastActivity = start;
+  while (millis() - start < timeout) {
+    int c = read();
+    if (c < 0) {
+      if (millis() - lastActivity >=
+          (_responseStarted ? _charTimeout : _startTimeout)) {
+        break;  // the applicable deadline passed without a character
+      }
+      continue;  // nothing in the buffer yet
+    }
+    lastActivity = millis();
+    if (c == '\n' && gotCR) {
+      complete = true;  // <CR><LF> ends the response
+      break;
+    }
+    gotCR = (c == '\r');
+    if (gotCR) { continue; }  // the line ending is not stored
+    if (count >= len - 1) {
+      buf[count] = '\0';
+      return SDI12_READ_OVERFLOW;
+    }
+    // Fold characters into the CRC three characters behind the one being stored;
+    // when the response ends, the three newest characters - the CRC itself - have
+    // not been folded in, so no second traversal is needed.
+    if (checkCRC && count >= 3) {
+      crc = crcUpdate(crc, static_cast<uint8_t>(buf[count - 3]));
+    }
+    buf[count++] = static_cast<char>(c);
+  }
+  buf[count] = '\0';
 
-  // calculate the CRC for the data portion
-  String calcCRC = crcToString(calculateCRC(recString));
+  if (!complete) { return SDI12_READ_TIMEOUT; }
 
-  if (recCRC == calcCRC) {
-    return true;
-  } else {
-    return false;
+  if (checkCRC) {
+    if (count < 3) { return SDI12_READ_CRC_FAILURE; }
+    char calcCRC[3];
+    crcToChars(crcFinalize(crc), calcCRC);
+    if (calcCRC[0] != buf[count - 3] || calcCRC[1] != buf[count - 2] ||
+        calcCRC[2] != buf[count - 1]) {
+      return SDI12_READ_CRC_FAILURE;
+    }
+    count -= 3;  // strip the verified CRC characters
+    buf[count] = '\0';
+  }
+  return static_cast<int16_t>(count);
+}
+
+int16_t SDI12::transact(String& cmd, char* buf, size_t len, bool checkCRC,
+                        uint8_t retries, uint32_t timeout) {
+  return transact(cmd.c_str(), buf, len, checkCRC, retries, timeout);
+}
+
+int16_t SDI12::transact(const char* cmd, char* buf, size_t len, bool checkCRC,
+                        uint8_t retries, uint32_t timeout) {
+#if SDI12_RETRY_STATS_SLOTS > 0
+  SDI12RetryStats* stats = cmd[0] != '\0' ? retryStatsFor(cmd[0]) : nullptr;
+#endif
+  int16_t result = SDI12_READ_TIMEOUT;
+  for (uint8_t attempt = 0; attempt <= retries; attempt++) {
+    int8_t extraWake = SDI12_WAKE_DELAY;
+    if (attempt >= 1) {
+      // First escalation: the sensor may simply be waking more slowly than the
+      // specification asks, so extend the break.
+      extraWake = SDI12_RETRY_WAKE_MS;
+    }
+    if (attempt >= 2) {
+      // Second escalation: actively drive the line to marking and let it settle,
+      // draining any charge or induced noise off a marginal bus, then force a full
+      // wake sequence even though the awake window may not have lapsed.
+      forceHold();
+      delay(SDI12_RETRY_SETTLE_MS);
+      _busWoken = false;
+    }
+    clearBuffer();  // a stale partial response must not pollute this attempt
+    sendCommand(cmd, extraWake);
+    result = readResponse(buf, len, checkCRC, timeout);
+#ifdef SDI12_CHECK_PARITY
+    // The receive interrupt discards characters that fail parity, so a response can
+    // look complete (and even CRC-clean, without a CRC) while missing characters.
+    if (_parityFailure) { result = SDI12_READ_PARITY_FAILURE; }
+#endif
+#if SDI12_RETRY_STATS_SLOTS > 0
+    if (stats) {
+      stats->attempts++;
+      if (result < 0) { stats->failures++; }
+    }
+#endif
+    if (result >= 0) { return result; }
+  }
+#if SDI12_RETRY_STATS_SLOTS > 0
+  if (stats) { stats->transactionsFailed++; }
+#endif
+  return result;
+}
+
+#if SDI12_RETRY_STATS_SLOTS > 0
+SDI12RetryStats* SDI12::retryStatsFor(char address) {
+  for (uint8_t i = 0; i < SDI12_RETRY_STATS_SLOTS; i++) {
+    if (_retryStats[i].address == address) { return &_retryStats[i]; }
+    if (_retryStats[i].address == '\0') {  // first unused slot; claim it
+      _retryStats[i].address = address;
+      return &_retryStats[i];
+    }
+  }
+  return nullptr;  // table full; the transaction proceeds uncounted
+}
+
+SDI12RetryStats SDI12::getRetryStats(char address) {
+  for (uint8_t i = 0; i < SDI12_RETRY_STATS_SLOTS; i++) {
+    if (_retryStats[i].address == address) { return _retryStats[i]; }
+  }
+  SDI12RetryStats empty = {};
+  return empty;
+}
+
+void SDI12::clearRetryStats() {
+  memset(_retryStats, 0, sizeof(_retryStats));
+}
+#endif  // SDI12_RETRY_STATS_SLOTS > 0
+
+#if SDI12_WAKE_TABLE_SLOTS > 0
+int8_t SDI12::applyLearnedWakeTime(char address, int8_t extraWakeTime) {
+  if (address == '\0') { return extraWakeTime; }  // '\0' marks the unused slots
+  for (uint8_t i = 0; i < SDI12_WAKE_TABLE_SLOTS; i++) {
+    if (_wakeAddresses[i] == address) { return _wakeTimes[i]; }
+  }
+  return extraWakeTime;
+}
+
+bool SDI12::setLearnedWakeTime(char address, int8_t wakeTimeMs) {
+  if (address == '\0') { return false; }
+  for (uint8_t i = 0; i < SDI12_WAKE_TABLE_SLOTS; i++) {
+    if (_wakeAddresses[i] == address) {
+      if (wakeTimeMs < 0) {
+        _wakeAddresses[i] = '\0';  // the caller's extraWakeTime applies again
+      } else {
+        _wakeTimes[i] = wakeTimeMs;
+      }
+      return true;
+    }
+  }
+  if (wakeTimeMs < 0) { return true; }  // nothing to remove
+  for (uint8_t i = 0; i < SDI12_WAKE_TABLE_SLOTS; i++) {
+    if (_wakeAddresses[i] == '\0') {  // claim the first unused slot
+      _wakeAddresses[i] = address;
+      _wakeTimes[i]     = wakeTimeMs;
+      return true;
+    }
+  }
+  return false;  // table full; commands to this address keep the caller's value
+}
+
+int8_t SDI12::getLearnedWakeTime(char address) {
+  if (address == '\0') { return -1; }
+  for (uint8_t i = 0; i < SDI12_WAKE_TABLE_SLOTS; i++) {
+    if (_wakeAddresses[i] == address) { return _wakeTimes[i]; }
+  }
+  return -1;
+}
+
+void SDI12::clearLearnedWakeTimes() {
+  memset(_wakeAddresses, 0, sizeof(_wakeAddresses));
+}
+#endif  // SDI12_WAKE_TABLE_SLOTS > 0
+
+#ifdef SDI12_BINARY
+void SDI12::setBinaryMode(bool binary) {
+  _rxBinary = binary;
+}
+
+SDI12BinaryResult SDI12::readBinaryResponse(uint8_t* payload, uint16_t maxLen,
+                                            uint32_t timeout) {
+  SDI12BinaryResult result;
+  result.address  = '\0';
+  result.size     = 0;
+  result.crcValid = false;
+  result.complete = false;
+
+  uint16_t crc      = crcInit();
+  uint8_t  header   = 0;        // header bytes consumed: address + 2 size bytes
+  uint16_t size     = 0;        // payload size announced by the packet
+  uint16_t consumed = 0;        // payload bytes consumed (stored or discarded)
+  uint8_t  crcBytes[2];
+  uint8_t  crcGot = 0;
+  uint32_t start  = millis();
+
+  // As in readResponse(), the two-tier deadlines fail fast within the overall
+  // timeout: an absent packet costs only the response-start deadline.
+  uint32_t lastActivity = start;
+  while (millis() - start < timeout) {
+    int c = read();
+    if (c < 0) {
+      if (millis() - lastActivity >=
+          (_responseStarted ? _charTimeout : _startTimeout)) {
+        return result;  // the applicable deadline passed without a byte
+      }
+      continue;  // nothing in the buffer yet
+    }
+    lastActivity = millis();
+    if (header < 3) {
+      // <address><size LSB><size MSB>
+      if (header == 0) {
+        result.address = static_cast<char>(c);
+      } else {
+        size |= static_cast<uint16_t>(c) << ((header - 1) * 8);
+      }
+      crc = crcUpdate(crc, static_cast<uint8_t>(c));
+      header++;
+    } else if (consumed < size) {
+      crc = crcUpdate(crc, static_cast<uint8_t>(c));
+      if (consumed < maxLen) { payload[consumed] = static_cast<uint8_t>(c); }
+      consumed++;
+    } else {
+      // <CRC LSB><CRC MSB> closes the packet
+      crcBytes[crcGot++] = static_cast<uint8_t>(c);
+      if (crcGot == 2) {
+        uint16_t calc   = crcFinalize(crc);
+        result.crcValid = crcBytes[0] == static_cast<uint8_t>(calc & 0xFF) &&
+          crcBytes[1] == static_cast<uint8_t>(calc >> 8);
+        result.size     = consumed < maxLen ? consumed : maxLen;
+        result.complete = true;
+        return result;
+      }
+    }
+  }
+  return result;  // overall timeout with the packet still incomplete
+}
+
+SDI12BinaryResult SDI12::requestBinary(const char* cmd, uint8_t* payload,
+                                       uint16_t maxLen, uint32_t timeout) {
+  clearBuffer();
+  sendCommand(cmd);     // the command itself is standard 7E1
+  setBinaryMode(true);  // the response arrives as 8N1 binary frames
+  SDI12BinaryResult result = readBinaryResponse(payload, maxLen, timeout);
+  setBinaryMode(false);
+  return result;
+}
+
+// SDI-12 v1.4 transmits binary values least significant byte first, matching the
+// native byte order of every supported processor, so these are alignment-safe copies.
+uint16_t SDI12::binaryUint16(const uint8_t* p) {
+  uint16_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+int16_t SDI12::binaryInt16(const uint8_t* p) {
+  int16_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+uint32_t SDI12::binaryUint32(const uint8_t* p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+int32_t SDI12::binaryInt32(const uint8_t* p) {
+  int32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+float SDI12::binaryFloat(const uint8_t* p) {
+  float v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+#endif  // SDI12_BINARY
+
+SDI12ParseResult SDI12::parseValues(float* out, uint8_t maxValues, bool checkCRC,
+                                    uint32_t timeout) {
+  SDI12ParseResult result;
+  result.address    = '\0';
+  result.valueCount = 0;
+  result.crcValid   = false;
+  result.complete   = false;
+
+  // Drain the whole response in one pass; the CRC is folded in while copying.
+  char    buf[SDI12_BUFFER_SIZE];
+  int16_t got = readResponse(buf, sizeof(buf), checkCRC, timeout);
+  if (got == SDI12_READ_TIMEOUT || got == SDI12_READ_OVERFLOW) { return result; }
+  result.complete = true;
+  result.crcValid = checkCRC && got != SDI12_READ_CRC_FAILURE;
+  // On a CRC failure the data characters are still in buf (with the received CRC
+  // tacked on); parse them anyway so the caller can inspect them, but the crcValid
+  // flag marks them as untrustworthy.  The CRC characters themselves (0x40-0x7F)
+  // cannot be mistaken for a sign or a digit, so they never produce a bogus value.
+
+  parseValueBuffer(buf, out, maxValues, &result);
+  return result;
+}
+
+SDI12ParseResult SDI12::parseValues(const char* line, float* out, uint8_t maxValues,
+                                    bool checkCRC) {
+  SDI12ParseResult result;
+  result.address    = '\0';
+  result.valueCount = 0;
+  result.crcValid   = false;
+  result.complete   = true;  // the caller vouches for the line being whole
+
+  // Work on a copy trimmed of the trailing <CR><LF>, so the CRC check and split see
+  // only the body.
+  char   buf[SDI12_BUFFER_SIZE];
+  size_t len = 0;
+  while (line[len] != '\0' && line[len] != '\r' && line[len] != '\n' &&
+         len < sizeof(buf) - 1) {
+    buf[len] = line[len];
+    len++;
+  }
+  buf[len] = '\0';
+
+  if (checkCRC && len > 3) {
+    uint16_t crc = crcInit();
+    for (size_t i = 0; i < len - 3; i++) { crc = crcUpdate(crc, buf[i]); }
+    char calcCRC[4] = {0};
+    crcToChars(crcFinalize(crc), calcCRC);
+    result.crcValid = (buf[len - 3] == calcCRC[0] && buf[len - 2] == calcCRC[1] &&
+                       buf[len - 1] == calcCRC[2]);
+    if (result.crcValid) {
+      len -= 3;  // strip a verified CRC, like readResponse() does
+      buf[len] = '\0';
+    }
+    // on a mismatch the CRC characters stay for diagnostics; they cannot be
+    // mistaken for a sign or a digit, so they never produce a bogus value
+  }
+
+  parseValueBuffer(buf, out, maxValues, &result);
+  return result;
+}
+
+// The value-splitting pass shared by both parseValues() overloads.
+void SDI12::parseValueBuffer(const char* buf, float* out, uint8_t maxValues,
+                             SDI12ParseResult* result) {
+  if (buf[0] == '\0') { return; }  // an empty line carries no address
+  result->address = buf[0];
+
+  // Values are delimited by their leading polarity sign, per the specification, so
+  // the split is a simple scan - the same digit/decimal handling as parseFloat(),
+  // but without a timedPeek() round trip per character.
+  uint8_t count = 0;
+  size_t  i     = 1;
+  while (buf[i] != '\0') {
+    if (buf[i] != '+' && buf[i] != '-') {  // scan forward to the next delimiter
+      i++;
+      continue;
+    }
+    bool isNegative = (buf[i] == '-');
+    i++;
+    bool  isFraction = false;
+    bool  gotDigit   = false;
+    long  value      = 0;
+    float fraction   = 1.0;
+    while ((buf[i] >= '0' && buf[i] <= '9') || (buf[i] == '.' && !isFraction)) {
+      if (buf[i] == '.') {
+        isFraction = true;
+      } else {
+        value = value * 10 + buf[i] - '0';
+        if (isFraction) fraction *= 0.1;
+      }
+      gotDigit = (gotDigit || buf[i] != '.');
+      i++;
+    }
+    if (!gotDigit) { continue; }  // a bare sign is not a value
+    if (count < maxValues) {
+      float parsed = isFraction ? value * fraction : value;
+      out[count]   = isNegative ? -parsed : parsed;
+    }
+    // values beyond the array capacity are consumed but discarded
+    if (count < 255) { count++; }
   }
+  result->valueCount = count < maxValues ? count : maxValues;
 }
 
 /* ================ Interrupt Service Routine =======================================*/
 
-// Passes off responsibility for the interrupt to the active object.
+// Routes the interrupt to every listening instance whose pin level changed.  On
+// boards with per-pin interrupt attachment only the changed pin's instance is
+// checked in practice; on AVR pin-change groups the level comparison sorts out which
+// bus (or buses) the edge belongs to, so several buses can receive concurrently.
 void ISR_MEM_ACCESS SDI12::handleInterrupt() {
-  if (_activeObject) _activeObject->receiveISR();
+  sdi12timer_t thisBitTCNT = READTIME;  // one timestamp serves all buses
+  for (uint8_t i = 0; i < SDI12_MAX_BUSES; i++) {
+    SDI12* listener = _listeners[i];
+    if (listener == nullptr) { continue; }
+    uint8_t pinLevel = digitalRead(listener->_dataPin);
+    if (pinLevel != listener->_lastPinLevel) {
+      listener->_lastPinLevel = pinLevel;
+      listener->receiveISR(thisBitTCNT, pinLevel);
+    }
+  }
 }
 
 // Creates a blank slate of bits for an incoming character
@@ -661,14 +1828,115 @@ void ISR_MEM_ACCESS SDI12::receiveISR() {
 
   uint8_t pinLevel = digitalRead(_dataPin);  // current RX data level
 
+  _lastPinLevel = pinLevel;  // keep the dispatch table's level tracking in step
+  receiveISR(thisBitTCNT, pinLevel);
+}
+
+// The edge-decoding logic, split out so that backends which capture the edge
+// timestamp in hardware (see SDI12_USE_INPUT_CAPTURE) can feed in the latched time
+// and level instead of reading them in software after the interrupt fires.
+void ISR_MEM_ACCESS SDI12::receiveISR(sdi12timer_t thisBitTCNT, uint8_t pinLevel) {
+#ifdef SDI12_LINE_STATS
+  _lineStats.edgesSeen++;
+#endif
   // Check how many bit times have passed since the last change
   uint16_t rxBits = SDI12Timer::bitTimes(thisBitTCNT - prevBitTCNT);
 
-#if !(TICKS_PER_SECOND == 31250 && TIMER_INT_SIZE == 8)
+#if defined(SDI12_SLAVE) || defined(SDI12_GLITCH_FILTER) || defined(SDI12_LINE_EVENTS)
+  uint32_t nowMs = millis();
+#endif
+
+#ifdef SDI12_GLITCH_FILTER
+  // Glitch rejection: in valid 1200-baud data consecutive transitions are never less
+  // than one bit time apart, so an edge arriving within SDI12_GLITCH_TICKS of the
+  // previous one is a sub-bit noise pulse - the previous edge was its leading edge and
+  // this edge returns the line to the pre-glitch level.  Coalesce the pair by
+  // returning without touching the bit bookkeeping or prevBitTCNT, so the interrupted
+  // span continues to be timed from the last genuine transition and the pulse simply
+  // vanishes from the decoded timeline.
+  {
+    sdi12timer_t glitchTicks = static_cast<sdi12timer_t>(thisBitTCNT - prevBitTCNT);
+    bool isGlitch = glitchTicks < static_cast<sdi12timer_t>(SDI12_GLITCH_TICKS);
+    if (SDI12BoardTimerPolicy::rollsOverWithinChar) {
+      // On timers that roll over within a character a long span can alias to a small
+      // tick delta; a real sub-bit pulse also lands within the same (or the next)
+      // millisecond, so require both.  The branch folds away on other configurations.
+      isGlitch = isGlitch && (nowMs - _lastEdgeMillis) <= 1;
+    }
+    if (isGlitch) {
+      // If the pulse's leading edge was mistaken for a start bit on an idle line, no
+      // bits have been accumulated yet - cancel the phantom character outright.
+      if (pinLevel == LOW && rxState == 0x00 && rxMask == 0x01 && rxValue == 0x00) {
+        rxState = WAITING_FOR_START_BIT;
+      }
+#ifdef SDI12_LINE_STATS
+      _lineStats.glitchesRejected++;
+#endif
+      return;
+    }
+  }
+#endif  // SDI12_GLITCH_FILTER
+
   // if we haven't had a bit spacing between the last interrupt, just ignore and move on
   // NOTE: In case of timer/prescaler settings that will rollover with each character,
-  // we can't rely on this check!!
-  if (rxBits == 0) { return; }
+  // we can't rely on this check!!  The timer policy flags those configurations at
+  // compile time, so the disabled branch folds away entirely.
+  if (!SDI12BoardTimerPolicy::rollsOverWithinChar && rxBits == 0) {
+#ifdef SDI12_LINE_STATS
+    _lineStats.framingAnomalies++;
+#endif
+    return;
+  }
+
+#ifdef SDI12_LINE_EVENTS
+  // Classify the line condition the span ending at this edge represents, with the
+  // same interval math the decoder runs anyway.  This is a parallel read-out for bus
+  // monitors and slave wake logic - nothing here touches the bit bookkeeping.
+  {
+    uint8_t events = 0;
+    if (nowMs - _lastEdgeMillis > SDI12_LINE_IDLE_MS) {
+      // the line sat inactive past the idle threshold; the sensors were asleep
+      events |= SDI12_LINE_EVENT_IDLE;
+    }
+    if (pinLevel == LOW && (rxBits >= 12 || nowMs - _lastEdgeMillis >= 12)) {
+      // a falling edge ending >=12 bit times of continuous spacing: a wake break
+      // (the same recognition bounds as the slave engine's break detection)
+      events |= SDI12_LINE_EVENT_BREAK;
+      _breakMillis  = nowMs;
+      _breakPending = true;
+    } else if (pinLevel == HIGH && _breakPending) {
+      if (rxBits >= 10 || nowMs - _lastEdgeMillis >= 8) {
+        // a rising edge ending >=8.33 ms of marking after a break: the wake
+        // sequence is complete and this edge is the command's first start bit
+        events |= SDI12_LINE_EVENT_MARKING;
+        _markingMillis = nowMs;
+      }
+      _breakPending = false;  // either way, the break's marking period is over
+    }
+    if (events) {
+      _lineEventFlags |= events;
+      if (_lineEventHandler) { _lineEventHandler(events); }
+    }
+  }
+#endif  // SDI12_LINE_EVENTS
+#ifdef SDI12_SLAVE
+  // Recognize a bus break: a falling edge that ends a long span of continuous
+  // spacing.  The specification requires recognizing spacing longer than 12 ms and
+  // ignoring spacing shorter than 6.5 ms; 12 bit times (10 ms) sits between the two.
+  // The bit-time count catches breaks on timers that don't roll over within one; the
+  // millis() comparison covers the timer/prescaler combinations that do.
+  if (_slaveAddress != '\0' && pinLevel == LOW && rxState != WAITING_FOR_START_BIT &&
+      (rxBits >= 12 || nowMs - _lastEdgeMillis >= 12)) {
+    _slaveBreak     = true;
+    _slaveCmdLen    = 0;                     // a break always begins a fresh command
+    rxState         = WAITING_FOR_START_BIT; // the spacing was a break, not data
+    _lastEdgeMillis = nowMs;
+    prevBitTCNT     = thisBitTCNT;
+    return;
+  }
+#endif
+#if defined(SDI12_SLAVE) || defined(SDI12_GLITCH_FILTER) || defined(SDI12_LINE_EVENTS)
+  _lastEdgeMillis = nowMs;  // this edge was genuine
 #endif
 
   // Check if we're ready for a start bit, and if this could possibly be it.
@@ -759,19 +2027,27 @@ void ISR_MEM_ACCESS SDI12::receiveISR() {
     // If this was the 8th or more bit then the character and parity are complete.
     // The stop bit may still be outstanding
     if (rxState > 7) {
-#ifdef SDI12_CHECK_PARITY
-      uint8_t rxParity = bitRead(rxValue, 7);  // pull out the parity bit
+#ifdef SDI12_LINE_STATS
+      _lineStats.charsCompleted++;
 #endif
-      rxValue &= 0x7F;  // Throw away the parity bit (and with 0b01111111)
-#ifdef SDI12_CHECK_PARITY
-      uint8_t checkParity =
-        parity_even_bit(rxValue);  // Calculate the parity bit from character w/o parity
-      if (rxParity != checkParity) { _parityFailure = true; }
-      if (!_parityFailure) {
+#ifdef SDI12_MINIMAL_ISR
+      // Deposit the raw bits and get out; the parity check, the buffer policy, and
+      // the message assembly all run from service() in task context, so none of
+      // them add to the interrupt's worst-case residency.
+      {
+        uint8_t nextTail = (_rawTail + 1) & (SDI12_RAW_RING_SIZE - 1);
+        if (nextTail == _rawHead) {
+          _bufferOverflow = true;  // the foreground stayed away too long
+#ifdef SDI12_LINE_STATS
+          _lineStats.bufferOverflows++;
 #endif
-        charToBuffer(rxValue);  // Put the finished character into the buffer
-#ifdef SDI12_CHECK_PARITY
+        } else {
+          _rawRing[_rawTail] = rxValue;
+          _rawTail           = nextTail;
+        }
       }
+#else
+      processChar(rxValue);  // parity policy and buffer deposit, in place
 #endif
 
       // if this is LOW, or we haven't exceeded the number of bits in a
@@ -789,19 +2065,164 @@ void ISR_MEM_ACCESS SDI12::receiveISR() {
     }
   }
   prevBitTCNT = thisBitTCNT;  // finally remember time stamp of this change!
+#ifdef SDI12_LINE_STATS
+  lineStatsIsrExit(thisBitTCNT);
+#endif
+}
+
+#ifdef SDI12_LINE_STATS
+// Folds one full decode pass into the min/max interrupt-duration counters.  The start
+// time is the edge timestamp taken when the interrupt fired, so the measured span also
+// includes any time another interrupt kept this one waiting.
+void ISR_MEM_ACCESS SDI12::lineStatsIsrExit(sdi12timer_t isrStart) {
+  sdi12timer_t elapsed = static_cast<sdi12timer_t>(READTIME - isrStart);
+  if (elapsed < _lineStats.minIsrTicks) { _lineStats.minIsrTicks = elapsed; }
+  if (elapsed > _lineStats.maxIsrTicks) { _lineStats.maxIsrTicks = elapsed; }
+}
+#endif  // SDI12_LINE_STATS
+
+// The per-character completion step: the binary-mode branch, the parity policy, and
+// the buffer deposit.  Runs inside the receive interrupt in a normal build, or from
+// service() in task context with SDI12_MINIMAL_ISR.
+void ISR_MEM_ACCESS SDI12::processChar(uint8_t raw) {
+#ifdef SDI12_BINARY
+  if (_rxBinary) {
+    // Binary (8N1) frames carry 8 data bits and no parity - the frame length is
+    // identical to 7E1, so only this final bookkeeping differs: keep the whole byte.
+    charToBuffer(raw);
+    return;
+  }
+#endif
+#ifdef SDI12_CHECK_PARITY
+  uint8_t rxParity = bitRead(raw, 7);  // pull out the parity bit
+#endif
+  raw &= 0x7F;  // Throw away the parity bit (and with 0b01111111)
+#ifdef SDI12_CHECK_PARITY
+  uint8_t checkParity =
+    parity_even_bit(raw);  // Calculate the parity bit from character w/o parity
+  if (rxParity != checkParity) {
+    _parityFailure = true;
+#ifdef SDI12_LINE_STATS
+    _lineStats.parityFailures++;
+#endif
+  }
+  if (!_parityFailure) {
+#endif
+    charToBuffer(raw);  // Put the finished character into the buffer
+#ifdef SDI12_CHECK_PARITY
+  }
+#endif
+}
+
+#ifdef SDI12_MINIMAL_ISR
+// Drains the raw ring deposited by the minimal interrupt, running the deferred
+// completion step on each character.  The interrupt only advances the write index
+// and this only advances the read index, so no interrupt masking is needed.
+uint8_t SDI12::service() {
+  uint8_t processed = 0;
+  while (_rawHead != _rawTail) {
+    uint8_t raw = _rawRing[_rawHead];
+    _rawHead    = (_rawHead + 1) & (SDI12_RAW_RING_SIZE - 1);
+    processChar(raw);
+    processed++;
+  }
+  return processed;
 }
+#endif  // SDI12_MINIMAL_ISR
 
 // Put a new character in the buffer
+// This runs inside the receive interrupt, so the index arithmetic is pure
+// add-and-mask - the power-of-two buffer size is enforced by a static_assert.
 void SDI12::charToBuffer(uint8_t c) {
   // Check for a buffer overflow. If not, proceed.
-  if ((_rxBufferTail + 1) % SDI12_BUFFER_SIZE == _rxBufferHead) {
+  if (((_rxBufferTail + 1) & (SDI12_BUFFER_SIZE - 1)) == _rxBufferHead) {
     _bufferOverflow = true;
+#ifdef SDI12_LINE_STATS
+    _lineStats.bufferOverflows++;
+#endif
   } else {
     // Save the character, advance buffer tail.
     _rxBuffer[_rxBufferTail] = c;
-    _rxBufferTail            = (_rxBufferTail + 1) % SDI12_BUFFER_SIZE;
+    _rxBufferTail            = (_rxBufferTail + 1) & (SDI12_BUFFER_SIZE - 1);
   }
+  _responseStarted = true;  // the response-start deadline has been met
+#ifdef SDI12_BINARY
+  if (_rxBinary) {
+    // Binary payload bytes can take any value, so the <CR><LF> message framing, the
+    // line queue, and the slave assembler do not apply; the packet is
+    // length-delimited and consumed by readBinaryResponse().
+    _prevRxChar = c;
+#ifdef SDI12_USE_RTOS
+    if (_notifyTask != nullptr) { SDI12_RTOS_NOTIFY_FROM_ISR(_notifyTask); }
+#endif
+#if SDI12_AWAKE_WINDOW_MS > 0
+    _lastLineActivity = millis();
+#endif
+    return;
+  }
+#endif
+#ifdef SDI12_SLAVE
+  // Feed the slave command assembler while the engine is enabled
+  if (_slaveAddress != '\0') { slaveHandleChar(c); }
+#endif
+#ifdef SDI12_LINE_QUEUE
+  // Assemble the character into the filling line slot.  A line that begins while
+  // every slot holds an unread response is discarded whole - the write slot is the
+  // oldest unread slot, which must stay immutable until it is read.  Characters
+  // beyond the longest spec-conforming response are dropped, but the line is still
+  // published on <CR><LF>.
+  if (_lineDropping || (_lineFillLen == 0 && _lineCount >= SDI12_LINE_QUEUE_SLOTS)) {
+    _lineDropping = true;
+  } else if (_lineFillLen < SDI12_LINE_SLOT_SIZE - 1) {
+    _lineSlots[_lineWriteSlot][_lineFillLen++] = static_cast<char>(c);
+  }
+#endif
+  // A <LF> directly after a <CR> is the end of every spec-conforming response; flag
+  // it and let the foreground know, so it can stop polling (or sleep) until then.
+  if (c == '\n' && _prevRxChar == '\r') {
+    _messageComplete = true;
+#ifdef SDI12_LINE_QUEUE
+    // Publish the completed line as one immutable unit, or count it dropped if the
+    // foreground had fallen a full pool behind when it began
+    if (!_lineDropping && _lineCount < SDI12_LINE_QUEUE_SLOTS) {
+      _lineSlots[_lineWriteSlot][_lineFillLen] = '\0';
+      _lineSlotLens[_lineWriteSlot]            = _lineFillLen;
+      _lineWriteSlot = (_lineWriteSlot + 1) % SDI12_LINE_QUEUE_SLOTS;
+      _lineCount++;
+    } else if (_linesDropped < 255) {
+      _linesDropped++;
+    }
+    _lineDropping = false;
+    _lineFillLen  = 0;
+#endif
+    if (_receiveHandler) { _receiveHandler(); }
+  }
+  _prevRxChar = c;
+#ifdef SDI12_USE_RTOS
+  // wake any task blocked in waitForChar()/waitForMessage()
+  if (_notifyTask != nullptr) { SDI12_RTOS_NOTIFY_FROM_ISR(_notifyTask); }
+#endif
+#if SDI12_AWAKE_WINDOW_MS > 0
+  // A sensor driving characters onto the line also restarts its awake window
+  _lastLineActivity = millis();
+#endif
+}
+
+// The input-capture interrupt handler: reads the hardware-latched edge timestamp,
+// infers the new line level from the edge direction that was armed, flips the capture
+// edge for the next transition, and hands both to the decoding logic.  Because the
+// timestamp was latched in silicon at the moment of the edge, competing interrupts
+// cannot jitter the measured bit times.
+#if defined(__AVR__) && defined(SDI12_USE_INPUT_CAPTURE)
+void SDI12::handleCaptureInterrupt() {
+  sdi12timer_t captured = SDI12_CAPTURE_REG;  // latched at the edge, in hardware
+  // If we were armed for a rising edge, the line just went HIGH (and vice versa)
+  uint8_t pinLevel = (TCCR1B & (1 << ICES1)) ? HIGH : LOW;
+  TCCR1B ^= (1 << ICES1);  // flip to catch the opposite edge next
+  TIFR1 = (1 << ICF1);     // changing ICES1 can set the flag; clear it
+  if (_activeObject) _activeObject->receiveISR(captured, pinLevel);
 }
+#endif
 
 // Define AVR interrupts
 // Check if the various interrupt vectors are defined.  If they are the ISR is
@@ -809,7 +2230,13 @@ void SDI12::charToBuffer(uint8_t c) {
 
 #if defined __AVR__  // Only AVR processors use interrupts like this
 
-#ifdef SDI12_EXTERNAL_PCINT
+#ifdef SDI12_USE_INPUT_CAPTURE
+
+ISR(TIMER1_CAPT_vect) {
+  SDI12::handleCaptureInterrupt();
+}
+
+#elif defined(SDI12_EXTERNAL_PCINT)
 // Client code must call SDI12::handleInterrupt() in PCINT handler for the data pin
 #else
 
@@ -840,3 +2267,39 @@ ISR(PCINT3_vect) {
 #endif  // SDI12_EXTERNAL_PCINT
 
 #endif  // __AVR__
+
+// Define the timer compare-match interrupts used for the asynchronous transmitter's
+// bit clock on boards that have a free compare channel on the SDI-12 timer.
+
+#if defined(SDI12_TIMER_COMPARE)
+
+#if defined(__AVR__) && defined(SDI12_USE_INPUT_CAPTURE)
+
+ISR(TIMER1_COMPA_vect) {
+  SDI12::handleTxBitInterrupt();
+}
+
+#elif defined(__AVR__)
+
+ISR(TIMER2_COMPA_vect) {
+  SDI12::handleTxBitInterrupt();
+}
+
+#elif defined(ARDUINO_SAMD_ZERO) || defined(__SAMD21G18A__) || \
+  defined(__SAMD21J18A__) || defined(__SAMD21E18A__)
+
+void TC3_Handler(void) {
+  SDI12_TC->COUNT16.INTFLAG.reg = TC_INTFLAG_MC0;  // clear the match flag
+  SDI12::handleTxBitInterrupt();
+}
+
+#elif defined(__SAMD51__) || defined(__SAME51__)
+
+void TC2_Handler(void) {
+  SDI12_TC->COUNT16.INTFLAG.reg = TC_INTFLAG_MC0;  // clear the match flag
+  SDI12::handleTxBitInterrupt();
+}
+
+#endif
+
+#endif  // SDI12_TIMER_COMPARE
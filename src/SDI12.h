@@ -131,10 +131,53 @@
 #include <Arduino.h>       // Arduino core library
 #include <Stream.h>        // Arduino Stream library
 #include "SDI12_boards.h"  //  Include timer information
+#include "SDI12_phy.h"     //  The pluggable physical-layer backend interface
 
 /// Helper for strings stored in flash
 typedef const __FlashStringHelper* FlashString;
 
+/// A user callback attached to an SDI-12 event (eg, the end of an asynchronous
+/// transmission).  Handlers may be called from interrupt context and should be short.
+typedef void (*SDI12Handler)(void);
+
+#if defined(SDI12_LINE_EVENTS) || defined(DOXYGEN)
+/// A user callback fired from the receive interrupt when a line condition is
+/// classified (`SDI12_LINE_EVENTS` build flag).  The argument is the
+/// #SDI12_LINE_EVENT_BREAK / #SDI12_LINE_EVENT_MARKING / #SDI12_LINE_EVENT_IDLE
+/// bits raised by the edge.  Called from interrupt context; keep it short.
+typedef void (*SDI12LineEventHandler)(uint8_t events);
+
+/** @brief A wake break was seen: a falling edge ended >=12 bit times of continuous
+ * spacing.  (`SDI12_LINE_EVENTS` build flag.) */
+#define SDI12_LINE_EVENT_BREAK 0x01
+/** @brief The post-break marking period completed: a rising edge - the first start
+ * bit of the command - ended >=8.33 ms of marking that followed a break.
+ * (`SDI12_LINE_EVENTS` build flag.) */
+#define SDI12_LINE_EVENT_MARKING 0x02
+/** @brief The line had been inactive for longer than #SDI12_LINE_IDLE_MS before
+ * this edge - the sensors were asleep and whatever follows needs a full wake
+ * sequence.  (`SDI12_LINE_EVENTS` build flag.) */
+#define SDI12_LINE_EVENT_IDLE 0x04
+
+#ifndef SDI12_LINE_IDLE_MS
+/**
+ * @brief The inactivity threshold, in milliseconds, past which the line is
+ * classified as idle (`SDI12_LINE_EVENTS` build flag).
+ *
+ * Defaults to the #SDI12_AWAKE_WINDOW_MS awake window, falling back to the
+ * specification's 87 ms when the awake-window break elision is disabled (window 0).
+ */
+#define SDI12_LINE_IDLE_MS (SDI12_AWAKE_WINDOW_MS > 0 ? SDI12_AWAKE_WINDOW_MS : 87)
+#endif
+#endif  // SDI12_LINE_EVENTS
+
+#if defined(SDI12_SLAVE) || defined(DOXYGEN)
+/// A slave-engine callback for addressed commands with no pre-registered response.
+/// The argument is the complete null-terminated command, address through the `!`.
+/// Called from interrupt context; keep it short.
+typedef void (*SDI12CommandHandler)(const char* command);
+#endif
+
 /// a char not found in a valid ASCII numeric field
 #define NO_IGNORE_CHAR '\x01'
 
@@ -178,7 +221,7 @@ typedef const __FlashStringHelper* FlashString;
 
 #ifndef SDI12_BUFFER_SIZE
 /**
- * @brief The buffer size for incoming SDI-12 data.
+ * @brief The buffer size for incoming SDI-12 data, which must be a power of two.
  *
  * All responses should be less than 81 characters:
  * - address is a single (1) character
@@ -186,8 +229,70 @@ typedef const __FlashStringHelper* FlashString;
  * - CRC is 3 characters
  * - CR is a single character
  * - LF is a single character
+ *
+ * The capacity is rounded up to 128 so the ring buffer indexes can wrap with a
+ * bitwise AND of `SDI12_BUFFER_SIZE - 1` instead of a modulo division.  AVR
+ * processors have no hardware divide, so the modulo was a software division inside
+ * the receive interrupt - right where latency determines whether bit timing stays
+ * within the RX_WINDOW_FUDGE margin.
  */
-#define SDI12_BUFFER_SIZE 81
+#define SDI12_BUFFER_SIZE 128
+#endif
+
+static_assert((SDI12_BUFFER_SIZE & (SDI12_BUFFER_SIZE - 1)) == 0,
+              "SDI12_BUFFER_SIZE must be a power of two");
+static_assert(SDI12_BUFFER_SIZE <= 256,
+              "SDI12_BUFFER_SIZE must fit the buffer's 8-bit indexes");
+
+#if defined(SDI12_MINIMAL_ISR) || defined(DOXYGEN)
+#ifndef SDI12_RAW_RING_SIZE
+/**
+ * @brief The capacity of the raw-character ring the minimal receive interrupt
+ * deposits into (`SDI12_MINIMAL_ISR` build flag).
+ *
+ * Sixteen characters is ~133 ms of line time at 1200 baud - ample slack for the
+ * foreground to get around to service().  Must be a power of two so the ring
+ * indexes wrap with a bitwise AND.
+ */
+#define SDI12_RAW_RING_SIZE 16
+#endif
+
+static_assert((SDI12_RAW_RING_SIZE & (SDI12_RAW_RING_SIZE - 1)) == 0,
+              "SDI12_RAW_RING_SIZE must be a power of two");
+static_assert(SDI12_RAW_RING_SIZE <= 256,
+              "SDI12_RAW_RING_SIZE must fit the ring's 8-bit indexes");
+#endif  // SDI12_MINIMAL_ISR
+
+#if defined(SDI12_LINE_QUEUE) || defined(DOXYGEN)
+#ifndef SDI12_LINE_QUEUE_SLOTS
+/**
+ * @brief The number of line slots in the complete-response queue (`SDI12_LINE_QUEUE`
+ * build flag).
+ *
+ * Two is the minimum for the next response to fill while the last is being parsed;
+ * three (the default) additionally keeps the most recently returned line valid while
+ * both of those are in flight.
+ */
+#define SDI12_LINE_QUEUE_SLOTS 3
+#endif
+/**
+ * @brief The size of one line slot: the longest spec-conforming response - an address,
+ * 75 data characters, a 3-character CRC, and `<CR><LF>` - plus a null terminator.
+ */
+#define SDI12_LINE_SLOT_SIZE 82
+#endif  // SDI12_LINE_QUEUE
+
+#ifndef SDI12_MAX_BUSES
+/**
+ * @brief The maximum number of SDI-12 instances that can *listen* at the same time.
+ *
+ * Each SDI-12 instance has its own Rx buffer and the interrupt dispatch routes each
+ * pin's edges to the instance listening on it, so buses on different pins can run
+ * measurement cycles genuinely in parallel.  This sets the size of the dispatch
+ * table; it costs one pointer per slot and one digitalRead() per listening bus in
+ * the receive interrupt.
+ */
+#define SDI12_MAX_BUSES 4
 #endif
 
 // SDI-12 Timing Specification
@@ -207,6 +312,93 @@ typedef const __FlashStringHelper* FlashString;
  * LOW for the marking.
  */
 #define SDI12_LINE_MARK_MICROS static_cast<uint16_t>(8400)
+#ifndef SDI12_AWAKE_WINDOW_MS
+/**
+ * @brief How long, in milliseconds, the sensors on the bus are assumed to stay awake
+ * after the last line activity.
+ *
+ * The specification requires sensors to respond to commands *not* preceded by a break
+ * for up to 87 milliseconds of marking after the previous command or response; only
+ * after 100 milliseconds of continuous marking may they return to low-power standby.
+ * Within this window sendCommand() elides the 12 ms break (and any wake delay) and
+ * sends only the required marking, which saves roughly 12 ms of bus time on every
+ * follow-up command - for example on each `aD0!` after an `aM!`.
+ *
+ * The default of 80 ms leaves a margin below the specification's 87 ms.  Define
+ * `SDI12_AWAKE_WINDOW_MS` as 0 to disable break elision and send the full wake
+ * sequence with every command.
+ */
+#define SDI12_AWAKE_WINDOW_MS 80
+#endif
+
+/**
+ * @brief The duration of the line break for asynchronous (interrupt-clocked)
+ * transmission, in bit times.  15 bit times is ~12.5ms, safely past the required 12ms.
+ */
+#define SDI12_TX_BREAK_BITS 15
+/**
+ * @brief The duration of the pre-command marking for asynchronous (interrupt-clocked)
+ * transmission, in bit times.  10 bit times is ~8.33ms, the required marking period.
+ */
+#define SDI12_TX_MARKING_BITS 10
+
+#ifndef SDI12_TX_BUFFER_SIZE
+/**
+ * @brief The maximum number of characters that can be queued for a single asynchronous
+ * transmission, and the depth of the write() transmit queue.
+ *
+ * Commands are short - the longest standard commands (eg, extended/vendor 'X' commands
+ * or aAb! address changes) are well under 16 characters.  Each queued character costs
+ * two bytes of RAM for its pre-computed frame.
+ *
+ * When emulating a sensor with the slave engine (the `SDI12_SLAVE` build flag), raise
+ * this to cover the longest registered response - an identity (`aI!`) response runs to
+ * 36 characters including the address, `<CR><LF>`, and an optional CRC.  Responses that
+ * do not fit are still sent, but from slaveService() in the main loop rather than by
+ * the interrupt-clocked transmitter.
+ */
+#define SDI12_TX_BUFFER_SIZE 16
+#endif
+
+#if defined(SDI12_SLAVE) || defined(DOXYGEN)
+#ifndef SDI12_SLAVE_MAX_RESPONSES
+/**
+ * @brief The number of command/response pairs the slave engine's response table holds.
+ *
+ * Eight covers an emulated sensor's usual set - `!`, `I!`, `M!`/`MC!`, and a few `Dn!`
+ * slots.  Each entry costs two pointers and a flag of RAM.
+ */
+#define SDI12_SLAVE_MAX_RESPONSES 8
+#endif
+/**
+ * @brief The longest inbound command, in characters, that the slave engine will
+ * assemble, including the address and the terminating `!`.
+ *
+ * The standard command set is at most five characters; eight leaves room for short
+ * vendor-extended (`aX...!`) commands.  Longer commands are discarded, not matched.
+ */
+#define SDI12_SLAVE_CMD_LEN 8
+#endif  // SDI12_SLAVE
+
+#if defined(SDI12_GLITCH_FILTER) || defined(DOXYGEN)
+#ifndef SDI12_GLITCH_TICKS
+/**
+ * @brief The glitch-rejection threshold for the receive interrupt, in timer ticks.
+ *
+ * With the `SDI12_GLITCH_FILTER` build flag, an edge arriving less than this many
+ * ticks after the previous one is treated as electrical noise - a sub-bit pulse from
+ * a pump motor or a long cable run - and coalesced with the previous line level
+ * instead of being decoded, so it cannot corrupt the bit bookkeeping of an in-flight
+ * character (which would otherwise cost a parity failure and a full retry cycle).
+ * In valid 1200-baud data consecutive transitions are never less than one bit time
+ * (833µs) apart, so anything well under that is noise; the default of a quarter bit
+ * time (~208µs) leaves plenty of margin for interrupt latency jitter on top of a
+ * genuine bit boundary.  Rejected edges are counted in
+ * SDI12LineStats::glitchesRejected when `SDI12_LINE_STATS` is also enabled.
+ */
+#define SDI12_GLITCH_TICKS (TICKS_PER_BIT / 4)
+#endif
+#endif  // SDI12_GLITCH_FILTER
 
 /**
  * Possible SDI-12 States
@@ -247,6 +439,27 @@ typedef const __FlashStringHelper* FlashString;
  */
 #define WAITING_FOR_START_BIT 0xFF
 
+/**
+ * @brief Returned by SDI12::readResponse() when no complete response arrived within
+ * the timeout.
+ */
+#define SDI12_READ_TIMEOUT -1
+/**
+ * @brief Returned by SDI12::readResponse() when the response's CRC did not match.
+ */
+#define SDI12_READ_CRC_FAILURE -2
+/**
+ * @brief Returned by SDI12::readResponse() when the caller's buffer was too small for
+ * the response.
+ */
+#define SDI12_READ_OVERFLOW -3
+/**
+ * @brief Returned by SDI12::transact() when a response arrived but a character in it
+ * failed the parity check.  Only raised when parity checking is enabled (ie, without
+ * `SDI12_IGNORE_PARITY`).
+ */
+#define SDI12_READ_PARITY_FAILURE -4
+
 
 #ifndef SDI12_IGNORE_PARITY
 /**
@@ -265,6 +478,59 @@ typedef const __FlashStringHelper* FlashString;
 #define SDI12_WAKE_DELAY 0
 #endif
 
+#ifndef SDI12_DEFAULT_RETRIES
+/**
+ * @brief The default number of retries for SDI12::transact() after a failed attempt,
+ * so a transaction makes at most `SDI12_DEFAULT_RETRIES + 1` attempts.
+ */
+#define SDI12_DEFAULT_RETRIES 2
+#endif
+
+#ifndef SDI12_RETRY_WAKE_MS
+/**
+ * @brief The extra wake time, in milliseconds, added to the break on every retried
+ * attempt of SDI12::transact() - the first escalation step, for sensors that need
+ * longer than the 12 ms break to wake.  Per protocol, the wake time must be less than
+ * 100 ms.
+ */
+#define SDI12_RETRY_WAKE_MS 10
+#endif
+
+#ifndef SDI12_RETRY_SETTLE_MS
+/**
+ * @brief How long, in milliseconds, SDI12::transact() actively holds the line at
+ * marking before the third and later attempts - the second escalation step, which
+ * drains any charge or induced noise off a marginal bus and forces a full wake
+ * sequence for the resend.
+ */
+#define SDI12_RETRY_SETTLE_MS 25
+#endif
+
+#ifndef SDI12_RETRY_STATS_SLOTS
+/**
+ * @brief The number of distinct sensor addresses SDI12::transact() keeps failure
+ * statistics for (7 bytes of RAM each).  Addresses beyond this many are still
+ * retried, just not counted.  Define as 0 to drop the statistics entirely.
+ */
+#define SDI12_RETRY_STATS_SLOTS 8
+#endif
+
+#ifndef SDI12_WAKE_TABLE_SLOTS
+/**
+ * @brief The number of distinct sensor addresses the learned wake-time table can
+ * hold (2 bytes of RAM each).
+ *
+ * SDI12::sendCommand() and SDI12::beginCommand() consult this table and, when the
+ * command's address has a learned entry, substitute it for the caller's
+ * `extraWakeTime` - so firmware that passes a global worst-case wake delay (sized
+ * for its slowest sensor) stops paying that delay on every command to its fast
+ * ones.  Entries are set with SDI12::setLearnedWakeTime(), typically from
+ * SDI12BusMap::learnWakeTimes() or a reloaded bus map.  Define as 0 to drop the
+ * table and the lookup entirely.
+ */
+#define SDI12_WAKE_TABLE_SLOTS 8
+#endif
+
 #ifndef SDI12_YIELD_MS
 /**
  * @brief The time to delay, in milliseconds, to allow the buffer to fill before
@@ -295,6 +561,86 @@ typedef const __FlashStringHelper* FlashString;
   { delay(SDI12_YIELD_MS); }
 #endif
 
+#if defined(SDI12_USE_RTOS) || defined(DOXYGEN)
+/**
+ * @def SDI12_RTOS_CURRENT_TASK
+ * @brief Hook returning an opaque handle for the calling task, stored for the receive
+ * interrupt to notify.
+ *
+ * @def SDI12_RTOS_WAIT
+ * @brief Hook that blocks the calling task until the receive interrupt posts a
+ * notification or the timeout (in milliseconds) expires; evaluates true when
+ * notified.
+ *
+ * @def SDI12_RTOS_NOTIFY_FROM_ISR
+ * @brief Hook, called from the receive interrupt, that posts a notification to the
+ * task whose handle is stored.
+ *
+ * With the `SDI12_USE_RTOS` build flag, the blocking read path waits on these hooks
+ * instead of burning fixed #SDI12_YIELD_MS delays.  On ESP32 they default to FreeRTOS
+ * direct-to-task notifications; on any other core, define all three (eg, over a
+ * semaphore or condition variable) before including this header or on the compiler
+ * command line.
+ */
+#if !defined(SDI12_RTOS_WAIT) || !defined(SDI12_RTOS_NOTIFY_FROM_ISR) || \
+  !defined(SDI12_RTOS_CURRENT_TASK)
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#define SDI12_RTOS_CURRENT_TASK() (xTaskGetCurrentTaskHandle())
+#define SDI12_RTOS_WAIT(timeoutMs) \
+  (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeoutMs)) > 0)
+#define SDI12_RTOS_NOTIFY_FROM_ISR(taskHandle)                          \
+  do {                                                                  \
+    BaseType_t sdi12HigherPrioWoken = pdFALSE;                          \
+    vTaskNotifyGiveFromISR(reinterpret_cast<TaskHandle_t>(taskHandle),  \
+                           &sdi12HigherPrioWoken);                      \
+    portYIELD_FROM_ISR(sdi12HigherPrioWoken);                           \
+  } while (0)
+#else
+#error \
+  "SDI12_USE_RTOS needs the ESP32 FreeRTOS defaults or user-supplied SDI12_RTOS_CURRENT_TASK / SDI12_RTOS_WAIT / SDI12_RTOS_NOTIFY_FROM_ISR hooks."
+#endif  // ESP32
+#endif  // hooks undefined
+#endif  // SDI12_USE_RTOS
+
+#if defined(SDI12_SLEEP_TX) || defined(DOXYGEN)
+#ifndef SDI12_TX_SLEEP
+/**
+ * @def SDI12_TX_SLEEP
+ * @brief Hook that drops the processor into its lightest sleep until the next
+ * interrupt.
+ *
+ * With the `SDI12_SLEEP_TX` build flag, the blocking send path (`sendCommand()`)
+ * hands the whole transmission - break, marking, and every bit - to the timer
+ * compare-match bit clock and executes this hook between edges instead of
+ * busy-waiting, cutting the active current draw for the ~25+ ms each command
+ * spends on the wire.  The defaults are idle sleep on AVR and `__WFI()` on ARM;
+ * both keep the peripheral clocks (and therefore the bit-clock timer) running
+ * and wake on any interrupt, so at worst the millis tick wakes the loop to
+ * re-check completion about once a millisecond.  Override the macro for cores
+ * with a different light-sleep idiom.  On boards without a free compare channel
+ * (no #SDI12_TIMER_COMPARE) the flag has no effect and the busy-wait path is
+ * used unchanged.
+ */
+#if defined(__AVR__)
+#include <avr/sleep.h>
+#define SDI12_TX_SLEEP()                \
+  do {                                  \
+    set_sleep_mode(SLEEP_MODE_IDLE);    \
+    sleep_enable();                     \
+    sleep_cpu();                        \
+    sleep_disable();                    \
+  } while (0)
+#elif defined(__arm__)
+#define SDI12_TX_SLEEP() __WFI()
+#else
+// no known wait-for-interrupt idiom; yield so an RTOS idle task can sleep for us
+#define SDI12_TX_SLEEP() SDI12_YIELD()
+#endif
+#endif  // SDI12_TX_SLEEP undefined
+#endif  // SDI12_SLEEP_TX
+
 #if defined(PARTICLE) || defined(ESP8266) ||          \
   (defined(ESP32) && !defined(ESP_ARDUINO_VERSION) && \
    !defined(ESP_ARDUINO_VERSION_VAL))
@@ -329,6 +675,103 @@ enum LookaheadMode {
 #endif  // NEED_LOOKAHEAD_ENUM
 #undef NEED_LOOKAHEAD_ENUM
 
+/**
+ * @brief The result of parsing one complete data-command response with
+ * SDI12::parseValues().
+ */
+struct SDI12ParseResult {
+  /** @brief The sensor address echoed at the start of the response, or '\0' if no
+   * complete response arrived within the timeout. */
+  char address;
+  /** @brief The number of values written into the caller's array. */
+  uint8_t valueCount;
+  /** @brief True when the CRC was requested and matched.  Always false when the CRC
+   * was not requested. */
+  bool crcValid;
+  /** @brief True when a complete `<CR><LF>`-terminated response was consumed; false
+   * on a timeout or an over-long response. */
+  bool complete;
+};
+
+/**
+ * @brief Per-address failure statistics kept by SDI12::transact().
+ *
+ * On a bus that mostly works, these counters show which sensor (or cable run) is
+ * eating the retries long before it degrades to hard failures.
+ */
+struct SDI12RetryStats {
+  /** @brief The sensor address the command was directed to ('\0' marks an unused
+   * slot). */
+  char address;
+  /** @brief The total number of command attempts, including first attempts. */
+  uint16_t attempts;
+  /** @brief The number of attempts that failed - timeout, CRC mismatch, parity
+   * failure, or an over-long response. */
+  uint16_t failures;
+  /** @brief The number of transactions that failed outright, with every retry
+   * exhausted. */
+  uint16_t transactionsFailed;
+};
+
+#if defined(SDI12_BINARY) || defined(DOXYGEN)
+/**
+ * @brief The result of capturing one high-volume binary (`aDBn!`) packet with
+ * SDI12::readBinaryResponse().  Only present with the `SDI12_BINARY` build flag.
+ */
+struct SDI12BinaryResult {
+  /** @brief The sensor address at the start of the packet, or '\0' if no packet
+   * header arrived within the timeout. */
+  char address;
+  /** @brief The number of payload bytes stored in the caller's buffer.  When the
+   * packet was larger than the buffer, the excess was consumed (so the CRC could
+   * still be verified) but discarded. */
+  uint16_t size;
+  /** @brief True when the packet's binary CRC matched. */
+  bool crcValid;
+  /** @brief True when the whole packet - header, payload, and CRC - was received
+   * within the timeout. */
+  bool complete;
+};
+#endif  // SDI12_BINARY
+
+#if defined(SDI12_LINE_STATS) || defined(DOXYGEN)
+/**
+ * @brief Counters describing the health of the SDI-12 line and the receive interrupt.
+ *
+ * This block is only maintained when the library is built with the
+ * `SDI12_LINE_STATS` flag; without the flag, the interrupt carries no extra cost.
+ *
+ * When a remote station starts returning timeouts, these counters distinguish a dead
+ * line (no edges at all), a marginal cable (edges but parity failures and framing
+ * anomalies), and a too-slow sketch (buffer overflows) with a single query - without a
+ * trip to the site with an oscilloscope.
+ *
+ * @see SDI12::getLineStats(), SDI12::clearLineStats()
+ */
+struct SDI12LineStats {
+  /** @brief The number of line transitions (receive interrupts) serviced. */
+  uint32_t edgesSeen;
+  /** @brief The number of characters completed (whether or not they were kept). */
+  uint16_t charsCompleted;
+  /** @brief The number of characters discarded for a parity mismatch.  Only counted
+   * when parity checking is enabled (ie, without `SDI12_IGNORE_PARITY`). */
+  uint16_t parityFailures;
+  /** @brief The number of interrupts discarded because less than one bit time had
+   * passed since the previous edge - electrical glitches or noise on the line. */
+  uint16_t framingAnomalies;
+  /** @brief The number of completed characters dropped because the Rx buffer was
+   * full. */
+  uint16_t bufferOverflows;
+  /** @brief The number of edges coalesced by the glitch filter.  Only counted when
+   * the library is also built with `SDI12_GLITCH_FILTER` - see #SDI12_GLITCH_TICKS. */
+  uint16_t glitchesRejected;
+  /** @brief The shortest observed receive-interrupt duration, in timer ticks. */
+  sdi12timer_t minIsrTicks;
+  /** @brief The longest observed receive-interrupt duration, in timer ticks. */
+  sdi12timer_t maxIsrTicks;
+};
+#endif  // defined(SDI12_LINE_STATS) || defined(DOXYGEN)
+
 /**
  * @brief The main class for SDI 12 instances
  */
@@ -349,11 +792,59 @@ class SDI12 : public Stream {
    * @brief The SDI12Timer instance to use for checking bit reception times.
    */
   static SDI12Timer sdi12timer;
+  /**
+   * @brief The dispatch table of instances currently listening for characters.
+   *
+   * The shared interrupt handler routes each edge to the listening instance whose
+   * pin level changed, so up to #SDI12_MAX_BUSES buses can receive concurrently.
+   */
+  static SDI12* _listeners[SDI12_MAX_BUSES];
+  /**
+   * @brief Enter an instance into the listener dispatch table.
+   *
+   * @param obj The instance that is starting to listen
+   */
+  static void addListener(SDI12* obj);
+  /**
+   * @brief Remove an instance from the listener dispatch table.
+   *
+   * @param obj The instance that is done listening
+   */
+  static void removeListener(SDI12* obj);
+  /**
+   * @brief The last data-pin level this instance saw, used by the shared interrupt
+   * handler to decide whether this instance's pin is the one that changed.
+   */
+  volatile uint8_t _lastPinLevel = 0;
 
   /**
    * @brief Stores the time of the previous RX transition in micros
    */
   sdi12timer_t prevBitTCNT;
+#if defined(SDI12_SLAVE) || defined(SDI12_GLITCH_FILTER) || \
+  defined(SDI12_LINE_EVENTS) || defined(DOXYGEN)
+  /**
+   * @brief The millis() stamp of the previous genuine line transition.
+   *
+   * Covers the timer/prescaler combinations whose tick counter rolls over within a
+   * break (slave break recognition, line-event classification) or within a character
+   * (glitch rejection), where the tick delta alone is ambiguous - and measures the
+   * idle gaps that are far too long for any tick counter.
+   */
+  volatile uint32_t _lastEdgeMillis = 0;
+#endif
+#if defined(SDI12_LINE_EVENTS) || defined(DOXYGEN)
+  /** @brief The accumulated, not-yet-polled line-event bits. */
+  volatile uint8_t _lineEventFlags = 0;
+  /** @brief True between a break and the completion of its marking period. */
+  volatile bool _breakPending = false;
+  /** @brief The millis() stamp of the last recognized break. */
+  volatile uint32_t _breakMillis = 0;
+  /** @brief The millis() stamp of the last completed post-break marking period. */
+  volatile uint32_t _markingMillis = 0;
+  /** @brief An optional user callback fired as line conditions are classified. */
+  SDI12LineEventHandler _lineEventHandler = nullptr;
+#endif
   /**
    * @brief Tracks how many bits are accounted for on an incoming character.
    *
@@ -384,6 +875,14 @@ class SDI12 : public Stream {
    * @brief the value of the character being built
    */
   uint8_t rxValue;
+#if defined(SDI12_BINARY) || defined(DOXYGEN)
+  /**
+   * @brief True while the receive interrupt is decoding binary (8-data-bit,
+   * no-parity) frames instead of the standard 7E1, for the high-volume binary
+   * (`aDB0!`...`aDB999!`) responses.  Set with setBinaryMode().
+   */
+  volatile bool _rxBinary = false;
+#endif
   /**@}*/
 
 
@@ -395,43 +894,149 @@ class SDI12 : public Stream {
    *
    * The buffer is used to store characters from the SDI-12 data line.  Characters are
    * read into the buffer when an interrupt is received on the data line. The buffer
-   * uses a circular implementation with pointers to both the head and the tail. All
-   * SDI-12 instances share the same buffer.
+   * uses a circular implementation with pointers to both the head and the tail. Each
+   * SDI-12 instance has its own buffer, so several buses on different pins can
+   * receive at the same time.
    *
-   * The default buffer size is the maximum length of a response to a normal SDI-12
-   * command, which is 81 characters:
+   * The longest response to a normal SDI-12 command is 81 characters:
    * - address is a single (1) character
    * - values has a maximum value of 75 characters
    * - CRC is 3 characters
    * - CR is a single character
    * - LF is a single character
    *
+   * The default buffer size is 128 - the next power of two above 81 - so that the
+   * ring indexes can wrap with a bitwise AND instead of a modulo division in the
+   * receive interrupt.
+   *
    * For more information on circular buffers:
    * http://en.wikipedia.org/wiki/Circular_buffer
    */
   /**@{*/
  private:
   /**
-   * @brief A single incoming character buffer for ALL SDI-12 objects (Rx buffer)
+   * @brief This instance's incoming character buffer (Rx buffer)
    *
-   * Increasing the buffer size will use more RAM. If you exceed 256 characters, be sure
-   * to change the data type of the index to support the larger range of addresses.  To
-   * adjust the size of the buffer, change the value of `SDI12_BUFFER_SIZE` in the
-   * header file.
+   * Increasing the buffer size will use more RAM *per instance*. If you exceed 256
+   * characters, be sure to change the data type of the index to support the larger
+   * range of addresses.  To adjust the size of the buffer, change the value of
+   * `SDI12_BUFFER_SIZE` in the header file.
    */
-  static uint8_t _rxBuffer[SDI12_BUFFER_SIZE];
+  uint8_t _rxBuffer[SDI12_BUFFER_SIZE];
   /**
    * @brief Index of buffer head. (unsigned 8-bit integer, can map from 0-255)
    */
-  static volatile uint8_t _rxBufferTail;
+  volatile uint8_t _rxBufferTail = 0;
   /**
    * @brief Index of buffer tail. (unsigned 8-bit integer, can map from 0-255)
    */
-  static volatile uint8_t _rxBufferHead;
+  volatile uint8_t _rxBufferHead = 0;
+#if defined(SDI12_MINIMAL_ISR) || defined(DOXYGEN)
+  /**
+   * @brief The raw completed characters (data bits plus parity bit, exactly as
+   * reconstructed) the minimal receive interrupt deposits for service() to process
+   * (`SDI12_MINIMAL_ISR` build flag).
+   */
+  volatile uint8_t _rawRing[SDI12_RAW_RING_SIZE];
+  /** @brief The raw ring's read index; only service() advances it. */
+  volatile uint8_t _rawHead = 0;
+  /** @brief The raw ring's write index; only the receive interrupt advances it. */
+  volatile uint8_t _rawTail = 0;
+#endif
   /**
    * @brief The buffer overflow status
    */
   bool _bufferOverflow = false;
+  /**
+   * @brief Set by the receive interrupt when a `<LF>` arrives directly after a
+   * `<CR>` - the end of every spec-conforming SDI-12 response.
+   */
+  volatile bool _messageComplete = false;
+  /**
+   * @brief The previous character placed in the Rx buffer, for spotting the
+   * `<CR><LF>` pair that ends a response.
+   */
+  uint8_t _prevRxChar = 0;
+  /**
+   * @brief An optional user callback fired from the receive interrupt when a
+   * complete response has arrived.
+   */
+  SDI12Handler _receiveHandler = nullptr;
+#if defined(SDI12_USE_RTOS) || defined(DOXYGEN)
+  /**
+   * @brief The opaque handle of the task blocked in waitForChar() or
+   * waitForMessage(), for the receive interrupt to notify; nullptr when no task is
+   * waiting.  Only present with the `SDI12_USE_RTOS` build flag.
+   */
+  void* volatile _notifyTask = nullptr;
+#endif
+  /**
+   * @brief Set by the receive interrupt when the first character of a response
+   * arrives; cleared when a new command is sent.  Selects which of the two response
+   * deadlines applies.
+   */
+  volatile bool _responseStarted = false;
+  /**
+   * @brief How long to wait for the first character of a response, in milliseconds.
+   *
+   * The specification requires a sensor to start its response within 15 ms of the
+   * command; the default of 20 ms adds margin.
+   */
+  uint16_t _startTimeout = 20;
+  /**
+   * @brief How long to wait between characters within a response, in milliseconds.
+   *
+   * The specification bounds gaps between characters at 1.66 ms (roughly 10 ms
+   * including the character itself); the default of 10 ms adds margin over one
+   * character time.
+   */
+  uint16_t _charTimeout = 10;
+#if defined(SDI12_LINE_QUEUE) || defined(DOXYGEN)
+  /**
+   * @brief The pool of complete-response line slots (`SDI12_LINE_QUEUE` build flag).
+   *
+   * The receive interrupt assembles characters into the slot at #_lineWriteSlot and
+   * publishes it - null terminated, as one immutable line - only when the `<CR><LF>`
+   * end-of-response pair arrives.  Each slot costs #SDI12_LINE_SLOT_SIZE bytes of RAM
+   * per instance.
+   */
+  char _lineSlots[SDI12_LINE_QUEUE_SLOTS][SDI12_LINE_SLOT_SIZE];
+  /** @brief The published length of each line slot, excluding the null terminator */
+  volatile uint8_t _lineSlotLens[SDI12_LINE_QUEUE_SLOTS];
+  /** @brief The slot the next readLine() will return */
+  volatile uint8_t _lineReadSlot = 0;
+  /** @brief The slot the receive interrupt is currently filling */
+  volatile uint8_t _lineWriteSlot = 0;
+  /** @brief The number of published lines not yet consumed by readLine() */
+  volatile uint8_t _lineCount = 0;
+  /** @brief Characters so far in the filling slot; touched only by the interrupt */
+  uint8_t _lineFillLen = 0;
+  /**
+   * @brief True while the interrupt is discarding an entire response because every
+   * slot held an unread line when the response began; touched only by the interrupt.
+   *
+   * A line that starts while the pool is full is dropped whole rather than stored
+   * into (and corrupting) the oldest unread slot, and rather than being published
+   * with its head missing if a slot frees up mid-response.
+   */
+  bool _lineDropping = false;
+  /** @brief Completed responses dropped because no slot was free */
+  volatile uint8_t _linesDropped = 0;
+#endif
+#if defined(SDI12_LINE_STATS) || defined(DOXYGEN)
+  /**
+   * @brief The line statistics block, maintained by the receive interrupt.
+   *
+   * Only present when the library is built with the `SDI12_LINE_STATS` flag.
+   */
+  volatile SDI12LineStats _lineStats;
+  /**
+   * @brief Fold the duration of one receive-interrupt pass into the min/max counters.
+   *
+   * @param isrStart The timer reading taken when the interrupt fired
+   */
+  void lineStatsIsrExit(sdi12timer_t isrStart);
+#endif
   /**@}*/
 
 
@@ -465,37 +1070,37 @@ class SDI12 : public Stream {
    * the Rx buffer.
    *
    * To understand how:
-   * `_rxBufferTail + SDI12_BUFFER_SIZE - _rxBufferHead) % SDI12_BUFFER_SIZE;`
+   * `(_rxBufferTail + SDI12_BUFFER_SIZE - _rxBufferHead) & (SDI12_BUFFER_SIZE - 1);`
    * accomplishes this task, we will use a few examples.
    *
-   * To start take the buffer below that has `SDI12_BUFFER_SIZE = 10`. The message
+   * To start take the buffer below that has `SDI12_BUFFER_SIZE = 8`. The message
    * "abc" has been wrapped around (circular buffer).
    *
    * @code{.cpp}
    *     _rxBufferTail = 1 // points to the '-' after c
-   *     _rxBufferHead = 8 // points to 'a'
+   *     _rxBufferHead = 6 // points to 'a'
    * @endcode
    *
-   * [ c ] [ - ] [ - ] [ - ] [ - ] [ - ] [ - ] [ - ]  [ a ] [ b ]
+   * [ c ] [ - ] [ - ] [ - ] [ - ] [ - ] [ a ] [ b ]
    *
-   * The number of available characters is (1 + 10 - 8) % 10 = 3
+   * The number of available characters is (1 + 8 - 6) & 7 = 3
    *
-   * The '%' or modulo operator finds the remainder of division of one number by
-   * another. In integer arithmetic 3 / 10 = 0, but has a remainder of 3.  We can only
-   * get the remainder by using the the modulo '%'. 3 % 10 = 3.  This next case
-   * demonstrates more clearly why the modulo is used.
+   * Because the buffer size is a power of two, ANDing with `SDI12_BUFFER_SIZE - 1`
+   * (a mask of all ones below the size bit) keeps only the remainder of division by
+   * the buffer size - the same result as the modulo operator, but without a division.
+   * This next case demonstrates more clearly why the wrap is needed.
    *
    * @code{.cpp}
    *     _rxBufferTail = 4 // points to the '-' after c
    *     _rxBufferHead = 1 // points to 'a'
    * @endcode
    *
-   * [ a ] [ b ] [ c ] [ - ] [ - ] [ - ] [ - ] [ - ]  [ - ] [ - ]
+   * [ a ] [ b ] [ c ] [ - ] [ - ] [ - ] [ - ] [ - ]
    *
-   * The number of available characters is (4 + 10 - 1) % 10 = 3
+   * The number of available characters is (4 + 8 - 1) & 7 = 3
    *
-   * If we did not use the modulo we would get either ( 4 + 10 - 1 ) = 13 characters or
-   * ( 4 + 10 - 1 ) / 10 = 1 character. Obviously neither is correct.
+   * If we did not mask we would get ( 4 + 8 - 1 ) = 11 characters, which is obviously
+   * not correct.
    *
    * If there has been a buffer overflow, available() will return -1.
    */
@@ -530,11 +1135,233 @@ class SDI12 : public Stream {
    */
   int read() override;
 
+  /// the inherited (timeout-blocking) `readBytes(char*, size_t)` remains available
+  using Stream::readBytes;
+  /**
+   * @brief Drain up to `n` buffered characters into a caller-supplied array with at
+   * most two memcpy()s.
+   *
+   * Draining a response one read() at a time costs a virtual call, two volatile
+   * index reads, and a masked increment per character.  This copies whatever is
+   * already buffered in bulk - one contiguous ring segment, or two when the data
+   * wraps - so a full 75-character response moves in at most two memcpy()s.
+   *
+   * @note Unlike the inherited Stream::readBytes(), this does **not** wait out a
+   * timeout for more characters: it returns what is buffered right now.  Use
+   * readResponse() to collect a complete response with the proper deadlines.
+   *
+   * @param dst The caller's array.
+   * @param n The most characters to copy.
+   * @return The number of characters copied, 0 when the buffer is empty.
+   */
+  size_t readBytes(uint8_t* dst, size_t n);
+  /**
+   * @brief Expose the buffered characters in place - no copy at all.
+   *
+   * @param ptr Set to the oldest buffered character inside the ring buffer, or
+   * `nullptr` when the buffer is empty (or a hardware backend holds the data).
+   * @return The number of contiguous characters readable at `*ptr` - up to the
+   * ring's wrap point, so a second call (after consuming the first segment) may be
+   * needed for the remainder.
+   *
+   * The characters are *not* consumed; parse or checksum them in place, then
+   * discard them with skipBytes().  The segment stays valid until something reads
+   * from or clears the buffer - the receive interrupt only appends.
+   */
+  size_t peekContiguous(const uint8_t** ptr);
+  /**
+   * @brief Discard up to `n` buffered characters without copying them anywhere -
+   * the consuming half of a zero-copy peekContiguous() pass.
+   *
+   * @param n The number of characters to discard.
+   * @return The number actually discarded (less than `n` when the buffer ran out).
+   */
+  size_t skipBytes(size_t n);
+
+  /**
+   * @brief Check whether a complete response is waiting in the Rx buffer.
+   *
+   * The receive interrupt recognizes the `<CR><LF>` pair that ends every SDI-12
+   * response and raises this flag as the final character arrives, so the foreground
+   * can wait on an actual end-of-response instead of spin-polling available() (which
+   * delays #SDI12_YIELD_MS on every call on fast processors) or waiting out the full
+   * stream timeout.
+   *
+   * The flag is cleared when a new command is sent and by clearBuffer().
+   *
+   * @return True if a complete `<CR><LF>`-terminated response has arrived since the
+   * last command.
+   */
+  bool messageAvailable();
+  /**
+   * @brief Set a callback to be fired as the final character of a response arrives.
+   *
+   * @param handler The function to call, or `nullptr` to remove a previous callback.
+   *
+   * @warning The callback runs inside the receive interrupt.  Keep it short - set a
+   * flag, note the time, or wake a task; never parse the response or print from it.
+   */
+  void onReceive(SDI12Handler handler);
+
+#if defined(SDI12_USE_RTOS) || defined(DOXYGEN)
+  /**
+   * @brief Block the calling task until at least one character is in the Rx buffer
+   * (`SDI12_USE_RTOS` build flag).
+   *
+   * @param timeoutMs The longest time to wait, in milliseconds.  The default of 10
+   * covers one character time at 1200 baud with margin.
+   * @return True if a character is available; false if the timeout expired.
+   *
+   * The receive interrupt posts a task notification as each character completes, so
+   * the task sleeps between characters instead of burning #SDI12_YIELD_MS of blind
+   * delay per read() call - the core is free for other work for all but the
+   * microseconds the interrupt and the wake take.  With the flag set, available(),
+   * read(), and peek() use this internally (bounded by one character time) when the
+   * buffer is empty.
+   *
+   * Notifications come from the software receive interrupt; a hardware PHY backend
+   * attached with setPhyBackend() does its own buffering and never posts them.
+   */
+  bool waitForChar(uint16_t timeoutMs = 10);
+  /**
+   * @brief Block the calling task until a complete `<CR><LF>`-terminated response
+   * has arrived (`SDI12_USE_RTOS` build flag).
+   *
+   * @param timeoutMs The longest time to wait, in milliseconds.
+   * @return True if a complete response is waiting (see messageAvailable()); false
+   * if the timeout expired.
+   *
+   * The task consumes exactly the time the bus takes: it sleeps until the receive
+   * interrupt sees the final `<LF>` of the response and notifies it.
+   */
+  bool waitForMessage(uint16_t timeoutMs);
+#endif  // SDI12_USE_RTOS
+
+#if defined(SDI12_LINE_QUEUE) || defined(DOXYGEN)
+  /**
+   * @brief The number of complete responses waiting in the line queue
+   * (`SDI12_LINE_QUEUE` build flag).
+   *
+   * @return The number of published, unread lines.
+   */
+  uint8_t linesAvailable();
+  /**
+   * @brief Take the oldest complete response from the line queue, by pointer.
+   *
+   * @param len An optional out-parameter receiving the line's length, excluding the
+   * null terminator.
+   * @return A pointer to the null-terminated response - including its `<CR><LF>` -
+   * or `nullptr` if no complete response is waiting.
+   *
+   * This is the zero-copy alternative to the Stream interface: the interrupt
+   * assembles each response into its own slot and publishes the whole line at once,
+   * so consuming it is a single pointer handoff - no per-character volatile index
+   * traffic, and no risk of reading half of an in-flight response.  The next
+   * response fills a different slot while this one is parsed (pass the pointer
+   * straight to the parseValues() buffer overload).
+   *
+   * The returned line remains valid until `SDI12_LINE_QUEUE_SLOTS - 1` further
+   * complete responses have been published, at which point the writer cycles back
+   * to its slot.
+   */
+  const char* readLine(uint8_t* len = nullptr);
+  /**
+   * @brief The number of complete responses dropped because every slot was full.
+   *
+   * @param clear True (the default) to zero the counter when reading it.
+   * @return The dropped-line count, saturating at 255.
+   */
+  uint8_t linesDropped(bool clear = true);
+#endif  // SDI12_LINE_QUEUE
+
+#if defined(SDI12_LINE_STATS) || defined(DOXYGEN)
+  /**
+   * @brief Get a copy of the line statistics block.
+   *
+   * Only available when the library is built with the `SDI12_LINE_STATS` flag.
+   * Interrupts are briefly suspended while the counters are copied so the snapshot is
+   * consistent.
+   *
+   * @return A snapshot of the ::SDI12LineStats counters
+   */
+  SDI12LineStats getLineStats();
   /**
-   * @brief Wait for sending to finish - because no TX buffering and the write function
-   * is blocking, we don't need to do anything.
+   * @brief Reset all of the line statistics counters.
+   *
+   * The minimum interrupt duration is reset to the largest value the timer type can
+   * hold so that the first interrupt after the reset establishes the new minimum.
    */
-  void flush() override {}
+  void clearLineStats();
+#endif
+
+#if defined(SDI12_LINE_EVENTS) || defined(DOXYGEN)
+  /**
+   * @brief Get - and clear - the line-condition events seen since the last poll
+   * (`SDI12_LINE_EVENTS` build flag).
+   *
+   * The receive interrupt classifies the span each edge closes with the same
+   * interval math the decoder already runs (SDI12Timer::bitTimes() against the
+   * previous edge's timestamp), so recognizing the 12 ms wake break, the completed
+   * 8.33 ms post-break marking, and an idle line costs a comparison per edge rather
+   * than an always-on polling loop.  A bus monitor can frame messages exactly at
+   * the wake sequence instead of guessing from character gaps, and a slave sketch
+   * gets spec-accurate wake detection for free.
+   *
+   * @return The accumulated #SDI12_LINE_EVENT_BREAK, #SDI12_LINE_EVENT_MARKING, and
+   * #SDI12_LINE_EVENT_IDLE bits; the pending set is cleared by the call.
+   */
+  uint8_t pollLineEvents();
+  /**
+   * @brief Get the millis() timestamp of the most recent wake break
+   * (`SDI12_LINE_EVENTS` build flag).
+   *
+   * @return The millis() value captured in the interrupt that recognized the break;
+   * 0 if none has been seen.
+   */
+  uint32_t lastBreakTime();
+  /**
+   * @brief Get the millis() timestamp of the most recent completed post-break
+   * marking period - the start of a command (`SDI12_LINE_EVENTS` build flag).
+   *
+   * @return The millis() value captured in the interrupt that ended the marking; 0
+   * if none has been seen.
+   */
+  uint32_t lastMarkingTime();
+  /**
+   * @brief Check whether the line has been inactive past the #SDI12_LINE_IDLE_MS
+   * threshold (`SDI12_LINE_EVENTS` build flag).
+   *
+   * The events only fire on edges, so a line that goes quiet and stays quiet raises
+   * #SDI12_LINE_EVENT_IDLE retroactively, at the next edge; this is the live poll
+   * for the same condition.
+   *
+   * @return True when no line transition has been seen for longer than the idle
+   * threshold.
+   */
+  bool lineIdle();
+  /**
+   * @brief Attach a callback fired from the receive interrupt as line conditions
+   * are classified (`SDI12_LINE_EVENTS` build flag).
+   *
+   * The callback receives the event bits the edge raised and runs in interrupt
+   * context - set a flag or grab a timestamp and get out.  Pass `nullptr` to
+   * detach.
+   *
+   * @param handler The function to call, or `nullptr`.
+   */
+  void setLineEventHandler(SDI12LineEventHandler handler);
+#endif
+
+  /**
+   * @brief Wait for the asynchronous transmitter to finish clocking out everything
+   * write() has queued.
+   *
+   * Returns immediately when nothing is queued, and is a no-op on boards without a
+   * timer compare channel, where write() is blocking and there is nothing to flush.
+   * With the `SDI12_SLEEP_TX` build flag the wait idle-sleeps between bit interrupts
+   * instead of spinning.
+   */
+  void flush() override;
 
   /**
    * @brief Return the first valid (long) integer value from the current position.
@@ -600,6 +1427,30 @@ class SDI12 : public Stream {
    * accepts a "+" as the start of a digit.
    */
   int peekNextDigit(LookaheadMode lookahead, bool detectDecimal);
+  /**
+   * @brief Read the next character, waiting no longer than the applicable response
+   * deadline.
+   *
+   * This hides the Stream version, which waits out the full blanket stream timeout.
+   * Here the wait is bounded by the two-tier deadlines instead: the response-start
+   * deadline before the first character of a response has arrived, and the much
+   * shorter inter-character deadline afterwards.  The specification bounds the start
+   * of a response at 15 ms after a command and gaps between characters at 1.66 ms,
+   * so an absent sensor or a response that dies mid-message is detected in
+   * milliseconds rather than after the 150 ms stream timeout.
+   *
+   * @see SDI12::setResponseTimeouts()
+   *
+   * @return The next character, or -1 if the deadline passed without one
+   */
+  int timedRead();
+  /**
+   * @brief Peek at the next character, waiting no longer than the applicable response
+   * deadline.
+   *
+   * @copydetails SDI12::timedRead()
+   */
+  int timedPeek();
   /**@}*/
 
 
@@ -615,6 +1466,12 @@ class SDI12 : public Stream {
    * @brief reference to the data pin
    */
   int8_t _dataPin = -1;
+  /**
+   * @brief The attached physical-layer backend, if any.
+   *
+   * When this is null (the default) the software bit-bang implementation is used.
+   */
+  SDI12Phy* _phy = nullptr;
 
  public:
   /**
@@ -703,6 +1560,24 @@ class SDI12 : public Stream {
    * @param value the value to return on timeout
    */
   void setTimeoutValue(int16_t value);
+  /**
+   * @brief Set the two-tier response deadlines used by the parse and read functions.
+   *
+   * Rather than waiting out a blanket stream timeout, this library bounds its waits
+   * with two deadlines matched to the specification's timing guarantees: a sensor
+   * must begin its response within 15 ms of a command, and may not pause more than
+   * 1.66 ms between characters once it has started.  An absent sensor therefore
+   * costs only the start deadline per probe (scanning all 62 addresses for absent
+   * sensors takes ~1.3 s instead of ~9.3 s), and a response that dies mid-message
+   * fails within the character deadline instead of the full timeout for every
+   * remaining parse call.
+   *
+   * @param startTimeoutMs The maximum wait for the first character of a response,
+   * in milliseconds; default 20.
+   * @param charTimeoutMs The maximum wait between characters within a response, in
+   * milliseconds; default 10 (a little over one 8.33 ms character time).
+   */
+  void setResponseTimeouts(uint16_t startTimeoutMs, uint16_t charTimeoutMs);
   /**
    * @brief Get the data pin for the current SDI-12 instance
    *
@@ -715,6 +1590,24 @@ class SDI12 : public Stream {
    * @param dataPin  The data pin's digital pin number
    */
   void setDataPin(int8_t dataPin);
+  /**
+   * @brief Attach a physical-layer backend to this SDI-12 instance.
+   *
+   * By default the library bit-bangs the data line in software - a pin change
+   * interrupt reconstructs incoming characters and a spin-wait clocks outgoing ones.
+   * On processors with peripherals that can do the 1200 baud 7E1 framing in hardware
+   * an ::SDI12Phy implementation can take over the whole character layer instead; the
+   * SDI12 object then delegates sending, receiving, and buffering to the backend while
+   * the stream parsing, CRC, and command helpers continue to work unchanged.
+   *
+   * This must be called *before* SDI12::begin(); pass `nullptr` to return to the
+   * software implementation (again, before calling begin()).
+   *
+   * @param phy The backend to attach, or `nullptr` for the software implementation
+   *
+   * @see SDI12ESP32UART
+   */
+  void setPhyBackend(SDI12Phy* phy);
 #ifdef SDI12_CHECK_PARITY
   bool _parityFailure;
 #endif
@@ -731,12 +1624,15 @@ class SDI12 : public Stream {
    * different pins.  SDI-12 can support up to 62 sensors on a single pin/bus, so it is
    * not necessary to use an instance for each sensor.
    *
-   * Because we are using pin change interrupts there can only be one active object at a
-   * time (since this is the only reliable way to determine which pin the interrupt
-   * occurred on).  The active object is the only object that will respond properly to
-   * interrupts.  However promoting another instance to Active status does not
-   * automatically remove the interrupts on the other pin. For proper behavior it is
-   * recommended to use this pattern:
+   * Each instance has its own Rx buffer, and the shared interrupt handler routes
+   * each pin's edges to whichever listening instance's pin level changed, so up to
+   * #SDI12_MAX_BUSES buses on different pins can *receive* concurrently - for
+   * example, three buses can run overlapping aC! measurement cycles genuinely in
+   * parallel.  The "active" object remains meaningful for the resources that are
+   * genuinely shared: the processor timer driving the bit clock and the asynchronous
+   * transmitter.  Only one instance can *transmit* at a time, and beginCommand()'s
+   * interrupt-clocked sender runs on the active object.  To promote another instance
+   * for transmission, use this pattern:
    *
    * @code{.cpp}
    *     mySDI12.forceHold();
@@ -919,6 +1815,68 @@ class SDI12 : public Stream {
    */
   /**@{*/
  private:
+  /**
+   * @brief The phases of an asynchronous (interrupt-clocked) transmission.
+   */
+  typedef enum SDI12_TX_PHASES {
+    /** No asynchronous transmission is in progress */
+    SDI12_TX_IDLE,
+    /** The line is being held HIGH for the wake break */
+    SDI12_TX_BREAK,
+    /** The line is being held LOW for the pre-command marking */
+    SDI12_TX_MARKING,
+    /** The bits of the queued characters are being clocked out */
+    SDI12_TX_DATA
+  } SDI12_TX_PHASES;
+
+  /**
+   * @brief Pre-computed 10-bit line frames for the characters queued for an
+   * asynchronous transmission.
+   *
+   * Bit 0 is the start bit and is sent first; bit 9 is the stop bit.  A 1 in the frame
+   * means the line is driven HIGH (spacing) for that bit slot, so the inverse-logic
+   * translation from character bits to line levels is done once, up front, rather than
+   * inside the bit-clock interrupt.
+   */
+  uint16_t _txFrames[SDI12_TX_BUFFER_SIZE];
+  /** @brief The number of frames queued in #_txFrames and not yet fully sent.
+   * Producers (beginCommand(), write()) increment it with interrupts off; the
+   * bit-clock interrupt decrements it as each frame's stop bit completes. */
+  volatile uint8_t _txFrameCount = 0;
+  /** @brief The ring index of the frame currently being clocked out */
+  volatile uint8_t _txFrameIndex = 0;
+  /** @brief The ring index write() will queue the next frame at.  Only touched from
+   * task context; when the transmitter is idle it equals #_txFrameIndex. */
+  uint8_t _txWriteIndex = 0;
+  /** @brief The index of the next bit to send within the current frame */
+  volatile uint8_t _txBitIndex = 0;
+  /** @brief The number of bit times remaining in the break or marking phase */
+  volatile uint8_t _txPhaseBitsLeft = 0;
+  /** @brief The current #SDI12_TX_PHASES value for the asynchronous transmitter */
+  volatile uint8_t _txPhase = SDI12_TX_IDLE;
+  /** @brief An optional user callback fired when an asynchronous transmission ends */
+  SDI12Handler _txCompleteHandler = nullptr;
+
+  /**
+   * @brief Pre-compute the 10 line levels for one outgoing character.
+   *
+   * @param outChar **uint8_t (char)** the character to frame
+   * @return A 10-bit frame; bit 0 (sent first) is the start bit, bits 1-7 are the
+   * (inverted) data bits, bit 8 is the (inverted) parity bit, and bit 9 is the stop
+   * bit.
+   */
+  static uint16_t buildFrame(uint8_t outChar);
+  /**
+   * @brief Advance the asynchronous transmitter by one bit; called from the timer
+   * compare-match interrupt once per bit time.
+   */
+  void txBitISR();
+  /**
+   * @brief Finish an asynchronous transmission: stop the bit clock, return the object
+   * to the listening state, and fire the transmit-complete handler, if one is set.
+   */
+  void endTransmission();
+
   /**
    * @brief Used to wake up the SDI12 bus.
    *
@@ -955,8 +1913,59 @@ class SDI12 : public Stream {
    * > • Sensors must return to a low-power standby mode after receiving an invalid
    * > address or after detecting a marking state on the data line for 100 milliseconds.
    * > (Tolerance:    +0.40 milliseconds.)
+   *
+   * Because sensors remain awake for up to 87 milliseconds of marking after the last
+   * activity on the line, the break (and any extra wake delay) is skipped when the bus
+   * is provably still awake - see #SDI12_AWAKE_WINDOW_MS.  In that case only the
+   * required marking time is topped up before the command.
    */
   void wakeSensors(int8_t extraWakeTime = 0);
+  /**
+   * @brief The value of millis() at the last known activity on the data line - the
+   * end of the last transmitted command or the last character received.
+   *
+   * Used by wakeSensors() to decide whether the sensors are still awake; only
+   * meaningful when #_busWoken is true.
+   */
+  uint32_t _lastLineActivity = 0;
+  /**
+   * @brief True after at least one full wake sequence has been sent, so that
+   * #_lastLineActivity holds a valid timestamp.
+   */
+  bool _busWoken = false;
+#if SDI12_RETRY_STATS_SLOTS > 0
+  /**
+   * @brief The per-address transaction statistics table, filled in first-come order
+   * by transact().
+   */
+  SDI12RetryStats _retryStats[SDI12_RETRY_STATS_SLOTS] = {};
+  /**
+   * @brief Find - or claim an unused slot for - the statistics entry for an address.
+   *
+   * @param address The sensor address the command is directed to.
+   * @return A pointer to the entry, or nullptr when the table is full (or the
+   * command was empty); the transaction then proceeds uncounted.
+   */
+  SDI12RetryStats* retryStatsFor(char address);
+#endif
+#if SDI12_WAKE_TABLE_SLOTS > 0
+  /** @brief The addresses with learned wake times, in first-come order ('\0' =
+   * unused slot). */
+  char _wakeAddresses[SDI12_WAKE_TABLE_SLOTS] = {};
+  /** @brief The learned extra wake time for the matching #_wakeAddresses entry, in
+   * milliseconds. */
+  int8_t _wakeTimes[SDI12_WAKE_TABLE_SLOTS] = {};
+  /**
+   * @brief Substitute an address's learned wake time for the caller's, if one has
+   * been learned.
+   *
+   * @param address The address character the outgoing command starts with.
+   * @param extraWakeTime The caller's extra wake time, in milliseconds.
+   * @return The learned wake time for the address, or `extraWakeTime` unchanged when
+   * nothing has been learned for it.
+   */
+  int8_t applyLearnedWakeTime(char address, int8_t extraWakeTime);
+#endif
   /**
    * @brief Used to send a character out on the data line
    *
@@ -972,23 +1981,62 @@ class SDI12 : public Stream {
    *
    * Recall that we are using inverse logic, so HIGH represents 0, and LOW represents
    * a 1.
+   *
+   * The character is framed with buildFrame() before the line is touched, then clocked
+   * out by writeFrame().
    */
   void writeChar(uint8_t out);
+  /**
+   * @brief Clock a pre-computed 10-bit frame out on the data line.
+   *
+   * @param frame A frame from buildFrame(); bit 0 (the start bit) is sent first and a
+   * 1 drives the line HIGH for that bit slot.
+   *
+   * On boards below 48MHz, all interrupts are disabled while the line is being
+   * actively driven HIGH, but only until the last HIGH (spacing) bit of the frame has
+   * been held for its bit time.  Every bit after that - the trailing 1s, the parity
+   * bit when it is a 1, and the stop bit - is LOW, identical to marking, so the span
+   * is timed out with interrupts live.  Because the frame arrives fully built (parity
+   * and inverse logic already folded in, the last HIGH bit found with a
+   * count-leading-zeros instruction), nothing but the pin writes and the bit waits
+   * happens with interrupts off.
+   */
+  void writeFrame(uint16_t frame);
 
  public:
   /**
-   * @brief Write out a byte on the SDI-12 line
+   * @brief Queue a byte for transmission on the SDI-12 line
    *
    * @param byte The character to write
-   * @return The number of characters written
-   *
-   * Sets the state to transmitting, writes a character, and then sets the state back to
-   * listening.  This function must be implemented as part of the Arduino Stream
-   * instance, but is *NOT* intended to be used for SDI-12 objects.  Instead, use the
-   * SDI12::sendCommand() or SDI12::sendResponse() functions.
+   * @return The number of characters queued (always 1)
+   *
+   * On boards with a free timer compare channel the character's frame is queued and
+   * the interrupt-driven bit clock drains the queue in the background, characters
+   * back-to-back with the line held at marking between them - so the whole Print
+   * formatting family (`print()` of floats, `F()` strings, and so on) works without
+   * blocking and without thrashing the line state per character.  If the queue is
+   * full (#SDI12_TX_BUFFER_SIZE frames), write() waits for the bit clock to free a
+   * slot (~8.33 ms per queued character); flush() waits for the whole queue.
+   *
+   * Without a timer compare channel (or with a hardware backend attached), the
+   * character is sent blocking, exactly as before.
+   *
+   * Note that write() sends *raw characters* - no break, no wake marking.  To
+   * address a sensor as a master, use SDI12::sendCommand(), which handles the wake
+   * sequence; a slave's marking-prefixed replies are SDI12::sendResponse()'s job.
    */
   virtual size_t write(uint8_t byte);
 
+  /**
+   * @brief Get the number of characters that can be queued with write() without
+   * blocking.
+   *
+   * @return The free space in the transmit queue, in characters.  On boards without
+   * a timer compare channel (or with a hardware backend), 1: there is no queue, but
+   * a blocking write() is always accepted.
+   */
+  int availableForWrite();
+
   /**
    * @brief Send a command out on the data line, acting as a data logger (master)
    *
@@ -1001,6 +2049,12 @@ class SDI12 : public Stream {
    * takes to wake before being ready to receive a command.  Default is 0ms - meaning
    * the sensor is ready for a command by the end of the 12ms break.  Per protocol, the
    * wake time must be less than 100 ms.
+   *
+   * With the `SDI12_SLEEP_TX` build flag (on boards where #SDI12_TIMER_COMPARE is
+   * defined), the break, marking, and bits are clocked out by the timer compare-match
+   * interrupt and the processor sleeps between edges via #SDI12_TX_SLEEP instead of
+   * busy-waiting, so the call still blocks until the command is on the wire but at
+   * idle rather than active current.
    */
   void sendCommand(String& cmd, int8_t extraWakeTime = SDI12_WAKE_DELAY);
   /// @copydoc SDI12::sendCommand(String&, int8_t)
@@ -1008,6 +2062,92 @@ class SDI12 : public Stream {
   /// @copydoc SDI12::sendCommand(String&, int8_t)
   void sendCommand(FlashString cmd, int8_t extraWakeTime = SDI12_WAKE_DELAY);
 
+  /**
+   * @brief Begin sending a command without blocking, acting as a data logger (master)
+   *
+   * @param cmd the command to send
+   * @param extraWakeTime The amount of additional time in milliseconds that the sensor
+   * takes to wake before being ready to receive a command.  Default is 0ms - meaning
+   * the sensor is ready for a command by the end of the 12ms break.  Per protocol, the
+   * wake time must be less than 100 ms.
+   * @return True if the command was queued (or, on boards without a usable timer
+   * compare channel, sent); false if a transmission is already in progress or the
+   * command is longer than #SDI12_TX_BUFFER_SIZE.
+   *
+   * On boards where #SDI12_TIMER_COMPARE is defined, this function queues the command
+   * and returns within a few tens of microseconds.  The break, marking, and character
+   * bits are then clocked out by a timer compare-match interrupt, one bit per
+   * interrupt, leaving the processor free for other work during the ~30-50ms that
+   * SDI12::sendCommand() would otherwise spend busy-waiting.  When the last stop bit
+   * has been sent the object automatically drops into the listening state and the
+   * transmit-complete handler (if set with SDI12::setTransmitCompleteHandler()) is
+   * called from the interrupt.
+   *
+   * On boards without a free compare channel this falls back to the blocking
+   * SDI12::sendCommand() path, so sketches can use the asynchronous API unconditionally
+   * and remain portable.
+   *
+   * Use SDI12::isTransmitting() to poll for completion instead of (or in addition to)
+   * the callback.
+   */
+  bool beginCommand(String& cmd, int8_t extraWakeTime = SDI12_WAKE_DELAY);
+  /// @copydoc SDI12::beginCommand(String&, int8_t)
+  bool beginCommand(const char* cmd, int8_t extraWakeTime = SDI12_WAKE_DELAY);
+  /// @copydoc SDI12::beginCommand(String&, int8_t)
+  bool beginCommand(FlashString cmd, int8_t extraWakeTime = SDI12_WAKE_DELAY);
+
+  /**
+   * @brief Check whether an asynchronous transmission is in progress
+   *
+   * @return True while a command queued by SDI12::beginCommand() is still being
+   * clocked out; false once the line has returned to the listening state.
+   */
+  bool isTransmitting();
+
+  /**
+   * @brief Set a handler to be called when an asynchronous transmission completes.
+   *
+   * @param handler The function to call; pass nullptr to remove a handler.  The
+   * handler is called from interrupt context and must be short - set a flag and
+   * return.
+   */
+  void setTransmitCompleteHandler(SDI12Handler handler);
+
+  /**
+   * @brief Start a new incremental CRC calculation.
+   *
+   * @return *uint16_t* The initial CRC accumulator value
+   *
+   * The incremental interface (crcInit() / crcUpdate() / crcFinalize()) allows the CRC
+   * to be accumulated as characters are drained from the Rx buffer, instead of in a
+   * second pass over a completed copy of the response:
+   *
+   * @code{.cpp}
+   *     uint16_t crc = SDI12::crcInit();
+   *     while (charsRemain) { crc = SDI12::crcUpdate(crc, nextChar); }
+   *     uint16_t result = SDI12::crcFinalize(crc);
+   * @endcode
+   */
+  static uint16_t crcInit();
+  /**
+   * @brief Fold one character into an incremental CRC calculation.
+   *
+   * Uses a 256-entry lookup table kept in flash, so each character costs a single
+   * table read instead of the specification's 8-iteration bit loop.
+   *
+   * @param crc The CRC accumulator returned by crcInit() or a prior crcUpdate()
+   * @param c **uint8_t (char)** the character to fold in
+   * @return *uint16_t* The updated CRC accumulator
+   */
+  static uint16_t crcUpdate(uint16_t crc, uint8_t c);
+  /**
+   * @brief Finish an incremental CRC calculation.
+   *
+   * @param crc The CRC accumulator
+   * @return *uint16_t* The final CRC value
+   */
+  static uint16_t crcFinalize(uint16_t crc);
+
   /**
    * @brief Calculates the 16-bit Cyclic Redundancy Check (CRC) for an SDI-12 message.
    *
@@ -1036,6 +2176,286 @@ class SDI12 : public Stream {
    */
   String crcToString(uint16_t crc);
 
+  /**
+   * @brief Converts a numeric 16-bit CRC to its three ASCII characters, without
+   * allocating.
+   *
+   * @param crc The 16-bit CRC
+   * @param buf A caller-supplied array of at least 3 characters to receive the ASCII
+   * encoding.  Exactly 3 characters are written; no null terminator is added.
+   *
+   * @see SDI12::crcToString(uint16_t)
+   */
+  static void crcToChars(uint16_t crc, char* buf);
+
+  /**
+   * @brief Read one complete response into a caller-supplied buffer, optionally
+   * verifying its CRC - without any heap allocation.
+   *
+   * Characters are drained from the Rx buffer into `buf` until a `<CR><LF>` line
+   * ending arrives or the timeout expires.  The line ending is not stored.  When
+   * `checkCRC` is true, the CRC is accumulated with the streaming interface while the
+   * characters are copied (one traversal, no temporary Strings); if it matches, the
+   * three CRC characters are stripped so `buf` holds only the data portion.
+   *
+   * @param buf A caller-supplied character buffer; always null-terminated on return.
+   * @param len The size of the buffer, including space for the null terminator.  For
+   * any standard response, #SDI12_BUFFER_SIZE characters is sufficient.
+   * @param checkCRC True to verify (and strip) the three-character CRC at the end of
+   * the response.
+   * @param timeout The maximum number of milliseconds to wait for the complete
+   * response.
+   * @return The number of characters placed in `buf` (excluding the line ending and
+   * a verified CRC), or one of the negative status codes #SDI12_READ_TIMEOUT,
+   * #SDI12_READ_CRC_FAILURE, or #SDI12_READ_OVERFLOW.  On a CRC failure the received
+   * characters, including the CRC, are left in `buf` for diagnostics.
+   */
+  int16_t readResponse(char* buf, size_t len, bool checkCRC = false,
+                       uint32_t timeout = 150);
+
+  /**
+   * @brief Send a command and read its verified response, retrying with an escalating
+   * strategy on failure.
+   *
+   * One call replaces the retry loop every deployment ends up hand-writing around
+   * SDI12::sendCommand() and SDI12::readResponse().  An attempt fails on a response
+   * timeout, a CRC mismatch, a parity failure, or an over-long response; because the
+   * read path fails fast on the response-start and inter-character deadlines (see
+   * setResponseTimeouts()), a retry starts the moment the failure is known rather
+   * than after a blanket stream timeout.  Failed attempts escalate:
+   *
+   * 1. The first attempt sends the command normally (with #SDI12_WAKE_DELAY).
+   * 2. Retries extend the break by #SDI12_RETRY_WAKE_MS of extra wake time, for
+   *    sensors that wake more slowly than the specification asks.
+   * 3. From the third attempt on, the line is first actively held at marking for
+   *    #SDI12_RETRY_SETTLE_MS (via forceHold()) to let a marginal bus settle, and a
+   *    full wake sequence is forced even within the awake window.
+   *
+   * Outcomes are tallied per sensor address - retrievable with getRetryStats() - so
+   * the sensor that is quietly eating retries can be spotted from the office.
+   *
+   * @param cmd The command to send, starting with the sensor address.
+   * @param buf A caller-supplied buffer for the response; always null-terminated on
+   * return.
+   * @param len The size of the buffer, including space for the null terminator.
+   * @param checkCRC True to verify (and strip) the three-character CRC at the end of
+   * the response.
+   * @param retries The number of times to retry after a failed attempt, so at most
+   * `retries + 1` attempts are made.
+   * @param timeout The maximum number of milliseconds to wait for each attempt's
+   * complete response.
+   * @return The number of characters placed in `buf` by the successful attempt, or
+   * the final attempt's negative status code: #SDI12_READ_TIMEOUT,
+   * #SDI12_READ_CRC_FAILURE, #SDI12_READ_OVERFLOW, or #SDI12_READ_PARITY_FAILURE.
+   */
+  int16_t transact(const char* cmd, char* buf, size_t len, bool checkCRC = false,
+                   uint8_t retries = SDI12_DEFAULT_RETRIES, uint32_t timeout = 150);
+  /// @copydoc SDI12::transact(const char*, char*, size_t, bool, uint8_t, uint32_t)
+  int16_t transact(String& cmd, char* buf, size_t len, bool checkCRC = false,
+                   uint8_t retries = SDI12_DEFAULT_RETRIES, uint32_t timeout = 150);
+
+#if SDI12_RETRY_STATS_SLOTS > 0 || defined(DOXYGEN)
+  /**
+   * @brief Get a copy of the transaction statistics for one sensor address.
+   *
+   * @param address The sensor address the commands were directed to.
+   * @return A snapshot of the ::SDI12RetryStats counters for that address; all zeros
+   * (with a '\0' address) if no transaction has been directed to it.
+   */
+  SDI12RetryStats getRetryStats(char address);
+  /**
+   * @brief Reset the transaction statistics for every address.
+   */
+  void clearRetryStats();
+#endif
+
+#if SDI12_WAKE_TABLE_SLOTS > 0 || defined(DOXYGEN)
+  /**
+   * @brief Record the learned minimum reliable extra wake time for one sensor
+   * address.
+   *
+   * Once an address has an entry, sendCommand() and beginCommand() use it in place
+   * of the `extraWakeTime` argument for every command addressed to that sensor, so a
+   * global worst-case wake delay is only ever paid by the sensor that needs it.
+   * Entries usually come from SDI12BusMap::learnWakeTimes(), which probes each
+   * discovered sensor downward from the configured maximum and verifies each step
+   * with a real response, or from a reloaded bus map that already holds the learned
+   * values.
+   *
+   * @param address The sensor address the wake time was learned for.
+   * @param wakeTimeMs The minimum reliable extra wake time in milliseconds, 0-100;
+   * pass a negative value to remove the address's entry so the caller's
+   * `extraWakeTime` applies again.
+   * @return True if the entry was stored (or removed); false when the table is full
+   * (#SDI12_WAKE_TABLE_SLOTS), in which case commands to this address keep using the
+   * caller's `extraWakeTime`.
+   */
+  bool setLearnedWakeTime(char address, int8_t wakeTimeMs);
+  /**
+   * @brief Get the learned extra wake time for one sensor address.
+   *
+   * @param address The sensor address.
+   * @return The learned wake time in milliseconds, or -1 when nothing has been
+   * learned for the address.
+   */
+  int8_t getLearnedWakeTime(char address);
+  /**
+   * @brief Remove every learned wake time, so the caller's `extraWakeTime` applies
+   * to all addresses again.
+   */
+  void clearLearnedWakeTimes();
+#endif
+
+#if defined(SDI12_BINARY) || defined(DOXYGEN)
+  /**
+   * @brief Switch the receive decoder between the standard 7E1 framing and the
+   * binary 8-data-bit, no-parity framing of high-volume binary responses
+   * (`SDI12_BINARY` build flag).
+   *
+   * SDI-12 v1.4 high-volume binary transfers move the same data in far fewer
+   * characters than the ASCII `aD0!` path: values are packed in their native binary
+   * widths instead of sign-delimited decimal text.  Both framings are 10 bits on the
+   * wire, so only the bit bookkeeping changes - in binary mode all 8 data bits are
+   * kept and no parity is checked, and the `<CR><LF>` message framing, the line
+   * queue, and the slave assembler are bypassed (payload bytes can take any value).
+   *
+   * The `aHB!` measurement command and its ASCII `atttnnnn<CR><LF>` response use the
+   * standard framing; switch to binary only for the `aDB0!`...`aDB999!` retrievals -
+   * or use requestBinary(), which handles the switch.
+   *
+   * @param binary True to decode 8N1 binary frames; false to return to 7E1.
+   */
+  void setBinaryMode(bool binary);
+
+  /**
+   * @brief Capture one high-volume binary (`aDBn!`) packet directly into a
+   * caller-supplied buffer, verifying its binary CRC in the same pass
+   * (`SDI12_BINARY` build flag).
+   *
+   * The packet is length-delimited rather than `<CR><LF>`-terminated:
+   * `<address><size LSB><size MSB><payload bytes><CRC LSB><CRC MSB>`, where the
+   * CRC-16 (the same polynomial as the ASCII CRC, transmitted as two raw bytes,
+   * least significant first) covers the address, size, and payload.  The receive
+   * decoder must already be in binary mode - see setBinaryMode().
+   *
+   * The same two-tier response deadlines as readResponse() apply within the overall
+   * timeout, so an absent response fails in tens of milliseconds.
+   *
+   * @param payload A caller-supplied buffer for the payload bytes.
+   * @param maxLen The capacity of the buffer.  Payload beyond it is consumed and
+   * discarded (keeping the CRC verifiable) but not stored.
+   * @param timeout The maximum number of milliseconds to wait for the whole packet.
+   * @return An ::SDI12BinaryResult with the source address, stored byte count, CRC
+   * validity, and completeness.
+   */
+  SDI12BinaryResult readBinaryResponse(uint8_t* payload, uint16_t maxLen,
+                                       uint32_t timeout = 1000);
+
+  /**
+   * @brief Send a command and capture its high-volume binary response
+   * (`SDI12_BINARY` build flag).
+   *
+   * Sends the command with the standard 7E1 framing, switches the receive decoder
+   * to binary for the response, captures the packet with readBinaryResponse(), and
+   * switches back - the whole `aDBn!` exchange in one call.
+   *
+   * @param cmd The retrieval command to send (`aDB0!`...`aDB999!`).
+   * @param payload A caller-supplied buffer for the payload bytes.
+   * @param maxLen The capacity of the buffer.
+   * @param timeout The maximum number of milliseconds to wait for the whole packet.
+   * @return An ::SDI12BinaryResult describing the captured packet.
+   */
+  SDI12BinaryResult requestBinary(const char* cmd, uint8_t* payload, uint16_t maxLen,
+                                  uint32_t timeout = 1000);
+
+  /**
+   * @anchor binary_accessors
+   * @name Typed accessors for packed binary payloads
+   *
+   * @brief Decode one packed value from a captured binary payload.
+   *
+   * SDI-12 v1.4 transmits binary values least significant byte first, which matches
+   * the native byte order of every supported processor (AVR, Cortex-M, Xtensa), so
+   * these reduce to an alignment-safe copy.
+   *
+   * @param p A pointer to the first byte of the value within the payload.
+   * @return The decoded value.
+   */
+  /**@{*/
+  static uint16_t binaryUint16(const uint8_t* p);
+  static int16_t  binaryInt16(const uint8_t* p);
+  static uint32_t binaryUint32(const uint8_t* p);
+  static int32_t  binaryInt32(const uint8_t* p);
+  static float    binaryFloat(const uint8_t* p);
+  /**@}*/
+#endif  // SDI12_BINARY
+
+  /**
+   * @brief Consume one complete data-command response and parse all of its values in
+   * a single pass.
+   *
+   * A data command (`aD0!`...`aD9!`) response is structured
+   * `<addr><values><CR><LF>` or `<addr><values><CRC><CR><LF>`, where each value is
+   * delimited by its leading polarity sign (+ or -).  This function drains the whole
+   * response with readResponse(), then splits it on the sign delimiters and converts
+   * each value - one traversal of the response, no Stream-timeout stalls between
+   * values, and no heap allocation.  Contrast with calling parseFloat() once per
+   * value, where each call can block for the full stream timeout and re-does its
+   * sign/decimal handling character by character.
+   *
+   * Values beyond `maxValues` are consumed but discarded, so the response is always
+   * fully drained from the buffer.
+   *
+   * @param out A caller-supplied array to receive the parsed values.
+   * @param maxValues The capacity of the `out` array.
+   * @param checkCRC True if the response ends with a three-character CRC that should
+   * be verified (ie, when the measurement was started with `aMC!` or `aCC!`).  When
+   * the CRC does not match, the values are still parsed but
+   * SDI12ParseResult::crcValid is false and the values should not be trusted.
+   * @param timeout The maximum number of milliseconds to wait for the complete
+   * response.
+   * @return An ::SDI12ParseResult with the source address, the number of values
+   * written, the CRC validity, and whether a complete response arrived.
+   */
+  SDI12ParseResult parseValues(float* out, uint8_t maxValues, bool checkCRC = false,
+                               uint32_t timeout = 150);
+
+  /**
+   * @brief Parse all of the values from an already-captured data-command response.
+   *
+   * The buffer counterpart of parseValues(float*, uint8_t, bool, uint32_t): the same
+   * one-pass sign-delimited split, but over a caller-supplied line - for example one
+   * returned by readLine() when the library is built with `SDI12_LINE_QUEUE` -
+   * instead of draining the Stream.  Trailing `<CR>` and `<LF>` characters are
+   * ignored.  SDI12ParseResult::complete is always true, since the caller vouches
+   * for the line being whole.
+   *
+   * @param line The null-terminated response, starting with the sensor address.
+   * @param out A caller-supplied array to receive the parsed values.
+   * @param maxValues The capacity of the `out` array.
+   * @param checkCRC True if the line ends with a three-character CRC that should be
+   * verified.  On a mismatch the values are still parsed (the CRC characters cannot
+   * be mistaken for a sign or digit) but SDI12ParseResult::crcValid is false.
+   * @return An ::SDI12ParseResult with the source address, the number of values
+   * written, and the CRC validity.
+   */
+  SDI12ParseResult parseValues(const char* line, float* out, uint8_t maxValues,
+                               bool checkCRC = false);
+
+ private:
+  /**
+   * @brief The value-splitting pass shared by both parseValues() overloads.
+   *
+   * @param buf The null-terminated response body, starting with the address.
+   * @param out The caller's value array.
+   * @param maxValues The capacity of `out`.
+   * @param result The result to fill with the address and value count; the
+   * completeness and CRC fields are the caller's responsibility.
+   */
+  static void parseValueBuffer(const char* buf, float* out, uint8_t maxValues,
+                               SDI12ParseResult* result);
+
+ public:
   /**
    * @brief Verifies that the CRC returned at the end of an SDI-12 message matches that
    * of the content of the message.
@@ -1063,6 +2483,151 @@ class SDI12 : public Stream {
   void sendResponse(FlashString resp, bool addCRC = false);
   ///@}
 
+#if defined(SDI12_SLAVE) || defined(DOXYGEN)
+  /**
+   * @anchor slave_fxns
+   * @name Slave / Responder Engine
+   *
+   * @brief An interrupt-driven engine for acting as an SDI-12 sensor, enabled with the
+   * `SDI12_SLAVE` build flag.
+   *
+   * The specification gives a sensor at most 15 ms from the end of a command to the
+   * start of its response.  Polling available() from loop() cannot guarantee that when
+   * the sketch is also busy sampling, so this engine does the time-critical work in
+   * interrupt context: commands are assembled character by character as they complete
+   * in the receive ISR, filtered against the slave address, matched against a table of
+   * pre-registered responses, and - on boards with a timer compare channel - the
+   * matching response is queued on the asynchronous transmitter immediately, starting
+   * on the line one marking period after the command's terminating `!`.
+   *
+   * Breaks (more than ~10 ms of continuous spacing) are recognized in the same ISR and
+   * reset the command assembly, so a command fragmented by a bus glitch cannot run
+   * into the next one.
+   *
+   * To use: begin(), setSlaveAddress(), registerResponse() for each command to answer,
+   * then forceListen().  Call slaveService() from loop() as a fallback transmitter for
+   * responses the interrupt path could not send (no timer compare channel, transmitter
+   * busy, or response longer than #SDI12_TX_BUFFER_SIZE).  Commands addressed to this
+   * sensor but absent from the table are passed to the onCommand() callback instead.
+   */
+  /**@{*/
+ private:
+  /// One pre-registered command/response pair for the slave engine.
+  struct SDI12SlaveResponse {
+    const char* command;   ///< the command after the address, eg "I!" or "D0!"
+    const char* response;  ///< the response body after the address, without `<CR><LF>`
+    bool        addCRC;    ///< true to append the three-character ASCII CRC
+  };
+  /// The address this object answers to; '\0' leaves the slave engine disabled.
+  char _slaveAddress = '\0';
+  /// The pre-registered response table.
+  SDI12SlaveResponse _slaveResponses[SDI12_SLAVE_MAX_RESPONSES];
+  /// The number of entries in use in the response table.
+  uint8_t _slaveResponseCount = 0;
+  /// The inbound command being assembled, address through `!`, null terminated.
+  char _slaveCmd[SDI12_SLAVE_CMD_LEN + 1];
+  /// The number of characters assembled so far in #_slaveCmd.
+  volatile uint8_t _slaveCmdLen = 0;
+  /// Flag raised by the receive ISR when a bus break is recognized.
+  volatile bool _slaveBreak = false;
+  /// Response-table index awaiting transmission by slaveService(), or -1 for none.
+  volatile int8_t _slavePending = -1;
+  /// The callback for addressed commands with no table entry.
+  SDI12CommandHandler _commandHandler = nullptr;
+  /**
+   * @brief Feed one completed inbound character to the slave command assembler.
+   *
+   * Runs in the receive ISR, immediately after the character is decoded.  On the
+   * terminating `!` the command is address-filtered and looked up in the response
+   * table; a match is queued on the asynchronous transmitter by beginSlaveResponse(),
+   * or deferred to slaveService() when that is not possible.
+   *
+   * @param c The completed character.
+   */
+  void slaveHandleChar(uint8_t c);
+  /**
+   * @brief Queue response-table entry `idx` on the asynchronous transmitter, from
+   * interrupt context.
+   *
+   * The response begins with the 8.33 ms marking (a slave never sends a break), so it
+   * starts on the line roughly one marking period after the command ends - far inside
+   * the 15 ms response-start deadline - regardless of what the main loop is doing.
+   *
+   * @param idx The response-table index to send.
+   * @return True if the response was queued; false if there is no bit clock, a
+   * transmission is already in progress, or the full response (address, body, optional
+   * CRC, and `<CR><LF>`) does not fit in #SDI12_TX_BUFFER_SIZE.
+   */
+  bool beginSlaveResponse(uint8_t idx);
+
+ public:
+  /**
+   * @brief Set the address this object answers to as a slave, enabling the engine.
+   *
+   * Commands addressed to `?` (the address query) are also answered.  Setting '\0'
+   * disables the engine again.
+   *
+   * @param address The sensor address to answer to.
+   */
+  void setSlaveAddress(char address);
+  /**
+   * @brief Get the address this object answers to as a slave.
+   *
+   * @return The slave address, or '\0' if the engine is disabled.
+   */
+  char getSlaveAddress();
+  /**
+   * @brief Register a canned response for one command.
+   *
+   * Both strings are stored by pointer, not copied, and must remain valid - string
+   * literals or static buffers.  A static buffer may be rewritten in place (eg, with
+   * fresh measurement values) between commands.  Re-registering a command replaces its
+   * previous entry.
+   *
+   * @param command The command to answer, without the address - eg "!", "I!", "M!",
+   * "D0!".
+   * @param response The response body, without the leading address or trailing
+   * `<CR><LF>` - both are added on transmission.  Eg "0012" for an M command promising
+   * two values in one second.
+   * @param addCRC True to append the three-character ASCII CRC (computed over the
+   * address and body) before the `<CR><LF>`, as `aMC!`/`aCC!` data responses require.
+   * @return True if the entry was stored; false if the table is full.
+   */
+  bool registerResponse(const char* command, const char* response, bool addCRC = false);
+  /**
+   * @brief Empty the response table.
+   */
+  void clearResponses();
+  /**
+   * @brief Set a callback for commands addressed to this sensor that have no response
+   * table entry.
+   *
+   * The callback runs in interrupt context with the complete command; it should do no
+   * more than stash the command and set a flag for loop() to act on.
+   *
+   * @param handler The function to call; nullptr to remove it.
+   */
+  void onCommand(SDI12CommandHandler handler);
+  /**
+   * @brief Check whether a bus break has been recognized.
+   *
+   * @param clear True (the default) to clear the flag when reading it.
+   * @return True if a break has been seen since the flag was last cleared.
+   */
+  bool slaveBreakReceived(bool clear = true);
+  /**
+   * @brief Transmit any matched response the interrupt path could not send; call
+   * regularly from loop().
+   *
+   * This is the blocking fallback for boards without a usable timer compare channel,
+   * for responses longer than #SDI12_TX_BUFFER_SIZE, and for commands arriving while
+   * the transmitter is busy.  When the interrupt path sent the response itself, this
+   * does nothing.
+   */
+  void slaveService();
+  /**@}*/
+#endif  // SDI12_SLAVE
+
   /**
    * @anchor interrupt_fxns
    * @name Interrupt Service Routine
@@ -1093,6 +2658,19 @@ class SDI12 : public Stream {
    * 60,000 ticks sitting idle per character.
    */
   void receiveISR();
+  /**
+   * @brief The edge-decoding logic behind receiveISR(), taking the transition
+   * timestamp and new line level as inputs.
+   *
+   * @param thisBitTCNT The timer count at the line transition
+   * @param pinLevel The line level after the transition (HIGH or LOW)
+   *
+   * Split out from receiveISR() so that backends which latch the edge timestamp in
+   * hardware (the input-capture backend, enabled with the `SDI12_USE_INPUT_CAPTURE`
+   * build flag) can feed in the captured time instead of a software read taken after
+   * the interrupt was serviced.
+   */
+  void receiveISR(sdi12timer_t thisBitTCNT, uint8_t pinLevel);
   /**
    * @brief Put a finished character into the SDI12 buffer
    *
@@ -1100,7 +2678,49 @@ class SDI12 : public Stream {
    */
   void charToBuffer(uint8_t c);
 
+  /**
+   * @brief Run the per-character completion step on one raw reconstructed character:
+   * the binary-mode branch, the parity extraction and `SDI12_CHECK_PARITY` policy,
+   * and the charToBuffer() deposit with all of its message assembly.
+   *
+   * In a normal build this runs inside the receive interrupt as each character's
+   * bits complete; with the `SDI12_MINIMAL_ISR` build flag it runs from service()
+   * in task context instead.
+   *
+   * @param raw The 8 reconstructed bits: 7 data bits plus the parity bit (or a full
+   * binary byte in binary mode).
+   */
+  void ISR_MEM_ACCESS processChar(uint8_t raw);
+
  public:
+#if defined(SDI12_MINIMAL_ISR) || defined(DOXYGEN)
+  /**
+   * @brief Run the character processing the minimal receive interrupt deferred
+   * (`SDI12_MINIMAL_ISR` build flag).
+   *
+   * With the flag defined, the receive interrupt only timestamps edges,
+   * reconstructs the raw bits, and deposits each completed character into a small
+   * raw ring - the parity computation, the `SDI12_CHECK_PARITY` buffer policy, and
+   * the message/line/slave assembly all run here, in task context, where they
+   * cannot add to the interrupt's worst-case residency.  A shorter interrupt
+   * coexists better with radio and timer interrupts - the jitter those inflict on
+   * neighboring interrupts is what forces a padded `RX_WINDOW_FUDGE`.
+   *
+   * available(), peek(), and read() call this themselves, so polling code works
+   * unchanged; call it directly from a loop() or RTOS task when using onReceive()
+   * or the line queue, whose callbacks and publishing now happen during service()
+   * rather than in the interrupt.  With `SDI12_USE_RTOS`, waitForChar() blocks on
+   * the interrupt's notification, so a waiting task should call service() when it
+   * wakes.
+   *
+   * The raw ring holds #SDI12_RAW_RING_SIZE characters (~133 ms of line time at the
+   * default 16); if the foreground stays away longer, the overflow is flagged the
+   * same way as a receive-buffer overflow.
+   *
+   * @return The number of characters processed by this call.
+   */
+  uint8_t service();
+#endif
   /**
    * @brief Intermediary used by the ISR - passes off responsibility for the interrupt
    * to the active object.
@@ -1109,6 +2729,26 @@ class SDI12 : public Stream {
    */
   static void handleInterrupt();
 
+  /**
+   * @brief Intermediary used by the timer compare-match interrupt - passes off
+   * responsibility for clocking out the next transmit bit to the active object.
+   *
+   * Only used on boards where #SDI12_TIMER_COMPARE is defined.
+   */
+  static void handleTxBitInterrupt();
+
+#if defined(SDI12_USE_INPUT_CAPTURE) || defined(DOXYGEN)
+  /**
+   * @brief Intermediary used by the timer input-capture interrupt - reads the
+   * hardware-latched edge timestamp and passes it, with the inferred line level, to
+   * the active object's decoding logic.
+   *
+   * Only available when the `SDI12_USE_INPUT_CAPTURE` build flag is set (standard AVR
+   * boards only); the data pin must then be the ICP1 pin.
+   */
+  static void handleCaptureInterrupt();
+#endif
+
   /** on AVR boards, uncomment to use your own PCINT ISRs */
   // #define SDI12_EXTERNAL_PCINT
   /**@}*/
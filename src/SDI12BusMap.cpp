@@ -0,0 +1,190 @@
+/**
+ * @file SDI12BusMap.cpp
+ * @copyright Stroud Water Research Center
+ * @license This library is published under the BSD-3 license.
+ * @author Kevin M.Smith <SDI12@ethosengineering.org>
+ *
+ * @brief This file implements the cached bus map.
+ */
+
+#include "SDI12BusMap.h"
+#include <string.h>
+
+/**
+ * @brief The serialization format version; bump when SDI12SensorRecord changes so
+ * stale stored maps are rejected instead of misread.
+ */
+#define SDI12_BUSMAP_FORMAT 2  // 2: added SDI12SensorRecord::wakeTimeMs
+
+SDI12BusMap::SDI12BusMap(SDI12& bus) : _bus(&bus) {}
+
+uint8_t SDI12BusMap::size() const {
+  return _count;
+}
+
+const SDI12SensorRecord* SDI12BusMap::get(uint8_t index) const {
+  if (index >= _count) { return nullptr; }
+  return &_records[index];
+}
+
+const SDI12SensorRecord* SDI12BusMap::find(char address) const {
+  for (uint8_t i = 0; i < _count; i++) {
+    if (_records[i].address == address) { return &_records[i]; }
+  }
+  return nullptr;
+}
+
+void SDI12BusMap::clear() {
+  _count = 0;
+}
+
+uint8_t SDI12BusMap::scan() {
+  clear();
+  // the valid address characters, in the order the specification lists them
+  for (char address = '0'; address <= 'z'; address++) {
+    if (!((address >= '0' && address <= '9') || (address >= 'A' && address <= 'Z') ||
+          (address >= 'a' && address <= 'z'))) {
+      continue;
+    }
+    if (_count >= SDI12_BUSMAP_MAX_SENSORS) { break; }
+    if (probe(address)) { _count++; }
+  }
+  return _count;
+}
+
+uint8_t SDI12BusMap::learnWakeTimes(int8_t maxWakeMs) {
+  // Long enough at marking for the library's awake-window elision to expire AND for
+  // the sensors themselves to drop back to sleep (the specification allows them
+  // ~100 ms of inactivity before they must be in their low-power state) - otherwise
+  // a trial would succeed regardless of the wake time and the descent would
+  // bottom out at a value that fails in the field.
+  const uint32_t sleepMs = (SDI12_AWAKE_WINDOW_MS > 100 ? SDI12_AWAKE_WINDOW_MS
+                                                        : 100) +
+    13;
+  uint8_t learned = 0;
+  for (uint8_t i = 0; i < _count; i++) {
+    SDI12SensorRecord& record = _records[i];
+    char               cmd[3] = {record.address, '!', '\0'};
+    char               resp[12];
+#if SDI12_WAKE_TABLE_SLOTS > 0
+    // the trials must control the wake time themselves, so drop any existing entry
+    // sendCommand() would otherwise substitute
+    _bus->setLearnedWakeTime(record.address, -1);
+#endif
+    int8_t best = -1;
+    for (int8_t wake = maxWakeMs; wake >= 0; wake--) {
+      delay(sleepMs);  // make sure this trial really has to wake the sensor
+      _bus->clearBuffer();
+      _bus->sendCommand(cmd, wake);
+      int16_t got = _bus->readResponse(resp, sizeof(resp));
+      if (got < 1 || resp[0] != record.address) { break; }
+      best = wake;  // verified: the sensor woke and answered at this wake time
+    }
+    if (best < 0) { continue; }  // failed even at maxWakeMs; leave unlearned
+    record.wakeTimeMs = best;
+#if SDI12_WAKE_TABLE_SLOTS > 0
+    _bus->setLearnedWakeTime(record.address, best);
+#endif
+    learned++;
+  }
+  return learned;
+}
+
+bool SDI12BusMap::probe(char address) {
+  SDI12SensorRecord& record = _records[_count];
+
+  // ack active: a! -> a<CR><LF>.  The fail-fast response-start deadline makes an
+  // absent address cost ~20 ms instead of the 150 ms stream timeout.
+  char cmd[6] = {address, '!', '\0'};
+  char resp[SDI12_BUFFER_SIZE];
+  _bus->clearBuffer();
+  _bus->sendCommand(cmd);
+  int16_t got = _bus->readResponse(resp, sizeof(resp));
+  if (got < 1 || resp[0] != address) { return false; }
+
+  record.address            = address;
+  record.identity[0]        = '\0';
+  record.measurementSeconds = 0;
+  record.measurementCount   = 0;
+  record.wakeTimeMs         = SDI12_BUSMAP_WAKE_UNKNOWN;
+
+  // identity: aI! -> allccccccccmmmmmmvvvxxx...xx<CR><LF>; keep the body
+  cmd[1] = 'I';
+  cmd[2] = '!';
+  cmd[3] = '\0';
+  _bus->clearBuffer();
+  _bus->sendCommand(cmd);
+  got = _bus->readResponse(resp, sizeof(resp));
+  if (got > 1 && resp[0] == address) {
+    strncpy(record.identity, resp + 1, SDI12_BUSMAP_IDENTITY_LEN - 1);
+    record.identity[SDI12_BUSMAP_IDENTITY_LEN - 1] = '\0';
+  }
+
+  // timing: aM! -> atttn; ttt is the wait in seconds, n the value count.  The
+  // measurement this starts is implicitly aborted by the next command addressed to
+  // the sensor, so nothing is retrieved and no wait is paid.
+  cmd[1] = 'M';
+  _bus->clearBuffer();
+  _bus->sendCommand(cmd);
+  got = _bus->readResponse(resp, sizeof(resp));
+  if (got >= 5 && resp[0] == address) {
+    record.measurementSeconds = (resp[1] - '0') * 100 + (resp[2] - '0') * 10 +
+      (resp[3] - '0');
+    uint8_t count = 0;
+    for (int16_t i = 4; i < got && resp[i] >= '0' && resp[i] <= '9'; i++) {
+      count = count * 10 + (resp[i] - '0');
+    }
+    record.measurementCount = count;
+  }
+  _bus->clearBuffer();  // discard any service request the aM! may elicit
+
+  return true;
+}
+
+size_t SDI12BusMap::serialize(uint8_t* buf, size_t len) const {
+  size_t needed = 4 + static_cast<size_t>(_count) * sizeof(SDI12SensorRecord);
+  if (len < needed) { return 0; }
+
+  buf[0] = SDI12_BUSMAP_FORMAT;
+  buf[1] = _count;
+  memcpy(buf + 2, _records, _count * sizeof(SDI12SensorRecord));
+
+  // checksum the version, count, and records with the library's CRC-16
+  uint16_t crc = SDI12::crcInit();
+  for (size_t i = 0; i < needed - 2; i++) { crc = SDI12::crcUpdate(crc, buf[i]); }
+  crc             = SDI12::crcFinalize(crc);
+  buf[needed - 2] = static_cast<uint8_t>(crc & 0xFF);
+  buf[needed - 1] = static_cast<uint8_t>(crc >> 8);
+  return needed;
+}
+
+bool SDI12BusMap::deserialize(const uint8_t* buf, size_t len) {
+  clear();
+  if (len < 4) { return false; }
+  if (buf[0] != SDI12_BUSMAP_FORMAT) { return false; }
+  uint8_t count = buf[1];
+  if (count > SDI12_BUSMAP_MAX_SENSORS) { return false; }
+
+  size_t needed = 4 + static_cast<size_t>(count) * sizeof(SDI12SensorRecord);
+  if (len < needed) { return false; }
+
+  uint16_t crc = SDI12::crcInit();
+  for (size_t i = 0; i < needed - 2; i++) { crc = SDI12::crcUpdate(crc, buf[i]); }
+  crc = SDI12::crcFinalize(crc);
+  if (buf[needed - 2] != static_cast<uint8_t>(crc & 0xFF) ||
+      buf[needed - 1] != static_cast<uint8_t>(crc >> 8)) {
+    return false;  // a corrupted or never-written storage area
+  }
+
+  memcpy(_records, buf + 2, count * sizeof(SDI12SensorRecord));
+  _count = count;
+#if SDI12_WAKE_TABLE_SLOTS > 0
+  // a warm boot gets the per-address wake savings without re-learning
+  for (uint8_t i = 0; i < _count; i++) {
+    if (_records[i].wakeTimeMs != SDI12_BUSMAP_WAKE_UNKNOWN) {
+      _bus->setLearnedWakeTime(_records[i].address, _records[i].wakeTimeMs);
+    }
+  }
+#endif
+  return true;
+}
@@ -0,0 +1,215 @@
+/**
+ * @file SDI12BusMap.h
+ * @copyright Stroud Water Research Center
+ * @license This library is published under the BSD-3 license.
+ * @author Kevin M.Smith <SDI12@ethosengineering.org>
+ *
+ * @brief This file contains a cached bus map: a fast scanner with a persistent
+ * address/identity store for quick startup.
+ */
+
+#ifndef SRC_SDI12BUSMAP_H_
+#define SRC_SDI12BUSMAP_H_
+
+#include "SDI12.h"
+
+#ifndef SDI12_BUSMAP_MAX_SENSORS
+/**
+ * @brief The maximum number of sensors the bus map can record.
+ *
+ * Each record costs ~40 bytes of RAM.  SDI-12 allows up to 62 addresses on a bus;
+ * raise this define if you really have more than 8 sensors on one pin.
+ */
+#define SDI12_BUSMAP_MAX_SENSORS 8
+#endif
+
+/**
+ * @brief The size of the identity field in a sensor record.
+ *
+ * An aI! response body holds at most 34 characters: 2 for the specification version,
+ * 8 for the vendor, 6 for the model, 3 for the sensor version, and up to 13 of serial
+ * number or other metadata.  One more byte holds the null terminator.
+ */
+#define SDI12_BUSMAP_IDENTITY_LEN 35
+
+/**
+ * @brief Everything the bus map remembers about one discovered sensor.
+ */
+struct SDI12SensorRecord {
+  /** @brief The sensor's address character. */
+  char address;
+  /** @brief The body of the sensor's aI! identity response (without the echoed
+   * address), null terminated. */
+  char identity[SDI12_BUSMAP_IDENTITY_LEN];
+  /** @brief The measurement wait time the sensor promised in its aM! reply (the
+   * `ttt` field), in seconds. */
+  uint16_t measurementSeconds;
+  /** @brief The number of values the sensor promised in its aM! reply (the `n`
+   * field). */
+  uint8_t measurementCount;
+  /** @brief The learned minimum reliable extra wake time for the sensor in
+   * milliseconds, or 0xFF when learnWakeTimes() has not (successfully) run for it. */
+  uint8_t wakeTimeMs;
+};
+
+/**
+ * @brief The SDI12SensorRecord::wakeTimeMs value meaning "not learned".
+ */
+#define SDI12_BUSMAP_WAKE_UNKNOWN 0xFF
+
+/**
+ * @brief A bus map that discovers the sensors on an SDI-12 bus once and can be
+ * stored and reloaded so later boots skip discovery entirely.
+ *
+ * Probing all 62 possible addresses with ack-active (`a!`) commands costs a wake
+ * sequence plus a response wait per address - historically tens of seconds before
+ * the first real measurement.  SDI12BusMap::scan() leans on the library's fail-fast
+ * response deadlines to cover the whole address space in about a second and records
+ * each discovered sensor's address, aI! identity, and aM! timing/value count.
+ *
+ * The serialize()/deserialize() pair reduces the map to a compact, checksummed byte
+ * block that the host can stash wherever it likes (EEPROM, flash, an SD card, or a
+ * server) and reload on warm boot:
+ *
+ * @code{.cpp}
+ *     SDI12BusMap busMap(mySDI12);
+ *     uint8_t blob[SDI12BusMap::SERIALIZED_MAX];
+ *     EEPROM.get(0, blob);
+ *     if (!busMap.deserialize(blob, sizeof(blob))) {
+ *       busMap.scan();  // cold boot: discover, then stash for next time
+ *       EEPROM.put(0, blob, busMap.serialize(blob, sizeof(blob)));
+ *     }
+ * @endcode
+ */
+class SDI12BusMap {
+ public:
+  /**
+   * @brief The largest number of bytes serialize() can produce.
+   */
+  static const size_t SERIALIZED_MAX = 4 +
+    SDI12_BUSMAP_MAX_SENSORS * sizeof(SDI12SensorRecord);
+
+  /**
+   * @brief Construct a new bus map bound to an SDI-12 bus.
+   *
+   * @param bus The SDI12 instance for the bus to map
+   */
+  explicit SDI12BusMap(SDI12& bus);
+
+  /**
+   * @brief Discover the sensors on the bus and fill the map.
+   *
+   * Each address in the range '0'-'9', 'A'-'Z', 'a'-'z' is probed with an
+   * ack-active (`a!`) command; addresses that acknowledge are queried for their aI!
+   * identity and their aM! timing and value count.  Any prior contents of the map
+   * are discarded.
+   *
+   * @note Issuing aM! starts a real measurement on the sensor; the measurement is
+   * implicitly aborted by the next command addressed to the sensor, so no data is
+   * retrieved and no measurement time is waited out.
+   *
+   * @return The number of sensors discovered.
+   */
+  uint8_t scan();
+
+  /**
+   * @brief Learn each mapped sensor's minimum reliable extra wake time and have the
+   * bus apply it automatically from then on.
+   *
+   * Firmware that passes a fixed `extraWakeTime` to every sendCommand() - sized for
+   * its slowest sensor - pays that extension of the break on every command to every
+   * sensor.  This probes downward instead: for each sensor in the map, starting from
+   * `maxWakeMs` and stepping down 1 ms at a time, the bus is first left idle long
+   * enough for both the library's awake-window elision and the sensor itself to fall
+   * asleep, then an ack-active (`a!`) command is sent with the trial wake time.  The
+   * descent stops at the first trial that gets no (or a garbled) response; the last
+   * verified value is stored in the sensor's record, pushed into the bus with
+   * SDI12::setLearnedWakeTime(), and carried through serialize()/deserialize() so a
+   * warm boot skips the learning pass too.
+   *
+   * Across a 10-sensor, 4-command-per-sensor measurement round with a 10 ms global
+   * wake delay, the learned values typically return ~400 ms of bus time per round -
+   * and the saving compounds with the awake-window break elision, which this does
+   * not disturb.
+   *
+   * @note Each trial must wait out the sensors' awake window, so learning costs
+   * roughly (`maxWakeMs` + 1) x ~120 ms per sensor.  Run it once at commissioning
+   * (or after rewiring) and persist the map, rather than on every boot.
+   *
+   * @param maxWakeMs The wake time to start probing down from - the global
+   * worst-case value the firmware would otherwise pass everywhere (0-100, default
+   * 10).
+   * @return The number of sensors a wake time was learned for.  Sensors that fail
+   * even at `maxWakeMs` are left unlearned and keep the caller's `extraWakeTime`.
+   */
+  uint8_t learnWakeTimes(int8_t maxWakeMs = 10);
+
+  /**
+   * @brief Get the number of sensors in the map.
+   *
+   * @return The number of records, whether scanned or deserialized.
+   */
+  uint8_t size() const;
+  /**
+   * @brief Get a sensor record by index.
+   *
+   * @param index The record index, 0 to size()-1
+   * @return A pointer to the record, or nullptr for an out-of-range index.
+   */
+  const SDI12SensorRecord* get(uint8_t index) const;
+  /**
+   * @brief Find a sensor record by address.
+   *
+   * @param address The sensor address
+   * @return A pointer to the record, or nullptr if the address is not in the map.
+   */
+  const SDI12SensorRecord* find(char address) const;
+  /**
+   * @brief Remove all records from the map.
+   */
+  void clear();
+
+  /**
+   * @brief Reduce the map to a compact byte block for persistent storage.
+   *
+   * The block holds a format version, the record count, the raw records, and a CRC
+   * over all of it (the same CRC-16 the SDI-12 data responses use), so a corrupted
+   * or never-written storage area is rejected on reload.
+   *
+   * @param buf The caller's buffer; #SERIALIZED_MAX bytes always suffice.
+   * @param len The size of the buffer.
+   * @return The number of bytes written, or 0 if the buffer is too small.
+   */
+  size_t serialize(uint8_t* buf, size_t len) const;
+  /**
+   * @brief Reload the map from a byte block produced by serialize().
+   *
+   * Any learned wake times in the block are pushed back into the bus with
+   * SDI12::setLearnedWakeTime(), so a warm boot gets the per-address wake savings
+   * without re-running learnWakeTimes().
+   *
+   * @param buf The stored block.
+   * @param len The number of available bytes (may be larger than the block).
+   * @return True if the block's version and CRC checked out and the map was loaded;
+   * false otherwise, in which case the map is left empty and a scan() is needed.
+   */
+  bool deserialize(const uint8_t* buf, size_t len);
+
+ private:
+  /**
+   * @brief Probe one address and, if a sensor acknowledges, fill in a record for it.
+   *
+   * @param address The address to probe
+   * @return True if a sensor acknowledged at this address.
+   */
+  bool probe(char address);
+
+  /** The SDI-12 bus the map describes */
+  SDI12* _bus;
+  /** The discovered (or reloaded) sensor records */
+  SDI12SensorRecord _records[SDI12_BUSMAP_MAX_SENSORS];
+  /** The number of valid records */
+  uint8_t _count = 0;
+};
+
+#endif  // SRC_SDI12BUSMAP_H_
@@ -0,0 +1,150 @@
+/**
+ * @file SDI12Scheduler.cpp
+ * @copyright Stroud Water Research Center
+ * @license This library is published under the BSD-3 license.
+ * @author Kevin M.Smith <SDI12@ethosengineering.org>
+ *
+ * @brief This file implements the concurrent-measurement scheduler.
+ */
+
+#include "SDI12Scheduler.h"
+
+SDI12Scheduler::SDI12Scheduler(SDI12& bus) : _bus(&bus) {}
+
+bool SDI12Scheduler::addAddress(char address) {
+  if (_sensorCount >= SDI12_SCHEDULER_MAX_SENSORS) { return false; }
+  if (indexOf(address) >= 0) { return false; }  // already registered
+  _sensors[_sensorCount].address = address;
+  _sensors[_sensorCount].state   = SDI12_SENSOR_IDLE;
+  _sensorCount++;
+  return true;
+}
+
+void SDI12Scheduler::clearAddresses() {
+  _sensorCount = 0;
+}
+
+void SDI12Scheduler::setDataHandler(SDI12DataHandler handler) {
+  _dataHandler = handler;
+}
+
+int8_t SDI12Scheduler::indexOf(char address) {
+  for (uint8_t i = 0; i < _sensorCount; i++) {
+    if (_sensors[i].address == address) { return static_cast<int8_t>(i); }
+  }
+  return -1;
+}
+
+SDI12Scheduler::SDI12_SENSOR_STATES SDI12Scheduler::sensorState(char address) {
+  int8_t i = indexOf(address);
+  if (i < 0) { return SDI12_SENSOR_FAILED; }
+  return static_cast<SDI12_SENSOR_STATES>(_sensors[i].state);
+}
+
+uint8_t SDI12Scheduler::startMeasurements(bool requestCRC) {
+  _requestCRC     = requestCRC;
+  uint8_t started = 0;
+  for (uint8_t i = 0; i < _sensorCount; i++) {
+    SDI12SensorSlot& slot = _sensors[i];
+    slot.returnedResults  = 0;
+    slot.dCommand         = 0;
+
+    // build aC! (or aCC! to request a CRC on the data responses)
+    char cmd[5] = {slot.address, 'C', '!', '\0', '\0'};
+    if (requestCRC) {
+      cmd[2] = 'C';
+      cmd[3] = '!';
+    }
+    _bus->clearBuffer();
+    _bus->sendCommand(cmd);
+
+    // The reply is atttnn<CR><LF>:
+    //   - a - the sensor address
+    //   - ttt - the time, in seconds, until the data will be ready
+    //   - nn - the number of values that will be returned (1-20 for concurrent)
+    char   resp[12] = {0};
+    size_t len      = _bus->readBytesUntil('\n', resp, sizeof(resp) - 1);
+    while (len > 0 && (resp[len - 1] == '\r' || resp[len - 1] == '\n')) {
+      resp[--len] = '\0';  // strip the line ending
+    }
+    _bus->clearBuffer();
+
+    if (len < 5 || resp[0] != slot.address) {
+      slot.state = SDI12_SENSOR_FAILED;  // no (or garbled) acknowledgement
+      continue;
+    }
+
+    uint16_t ttt = (resp[1] - '0') * 100 + (resp[2] - '0') * 10 + (resp[3] - '0');
+    uint8_t  expected = 0;
+    for (size_t j = 4; j < len && resp[j] >= '0' && resp[j] <= '9'; j++) {
+      expected = expected * 10 + (resp[j] - '0');
+    }
+
+    slot.expectedResults = expected;
+    slot.millisReady     = millis() + static_cast<uint32_t>(ttt) * 1000;
+    slot.state           = SDI12_SENSOR_MEASURING;
+    started++;
+  }
+  return started;
+}
+
+uint8_t SDI12Scheduler::poll() {
+  uint8_t pending  = 0;
+  bool    serviced = false;  // retrieve at most one sensor per call to keep the
+                             // caller's loop latency bounded
+  for (uint8_t i = 0; i < _sensorCount; i++) {
+    SDI12SensorSlot& slot = _sensors[i];
+    if (slot.state != SDI12_SENSOR_MEASURING) { continue; }
+    if (!serviced && millis() >= slot.millisReady) {
+      retrieve(slot);
+      serviced = true;
+    }
+    if (slot.state == SDI12_SENSOR_MEASURING) { pending++; }
+  }
+  return pending;
+}
+
+bool SDI12Scheduler::busy() {
+  for (uint8_t i = 0; i < _sensorCount; i++) {
+    if (_sensors[i].state == SDI12_SENSOR_MEASURING) { return true; }
+  }
+  return false;
+}
+
+void SDI12Scheduler::retrieve(SDI12SensorSlot& slot) {
+  float values[SDI12_SCHEDULER_VALUE_CHUNK];
+
+  while (slot.returnedResults < slot.expectedResults && slot.dCommand <= 9) {
+    // build aD0! ... aD9!
+    char cmd[6] = {slot.address, 'D', static_cast<char>('0' + slot.dCommand), '!',
+                   '\0'};
+    _bus->clearBuffer();
+    _bus->sendCommand(cmd);
+
+    // the first character of the response should echo the sensor's address
+    char addrChar = '\0';
+    if (_bus->readBytes(&addrChar, 1) == 0 || addrChar != slot.address) {
+      _bus->clearBuffer();
+      break;  // no response, or someone else's - give up on this sensor
+    }
+
+    // parse every value in the response; parseFloat() returns the timeout value as
+    // soon as the next character is not part of a number (the CRC or the <CR>)
+    uint8_t count = 0;
+    while (count < SDI12_SCHEDULER_VALUE_CHUNK) {
+      float value = _bus->parseFloat();
+      if (value == _bus->TIMEOUT) { break; }
+      values[count++] = value;
+    }
+    _bus->clearBuffer();  // discard the CRC characters and line ending
+
+    if (count == 0) { break; }  // an empty response means no more data is coming
+
+    slot.returnedResults += count;
+    if (_dataHandler) { _dataHandler(slot.address, values, count); }
+    slot.dCommand++;
+  }
+
+  slot.state = (slot.returnedResults >= slot.expectedResults) ? SDI12_SENSOR_DONE
+                                                              : SDI12_SENSOR_FAILED;
+}
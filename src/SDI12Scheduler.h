@@ -0,0 +1,203 @@
+/**
+ * @file SDI12Scheduler.h
+ * @copyright Stroud Water Research Center
+ * @license This library is published under the BSD-3 license.
+ * @author Kevin M.Smith <SDI12@ethosengineering.org>
+ *
+ * @brief This file contains a scheduler for pipelining concurrent measurements
+ * across multiple SDI-12 sensors on one bus.
+ */
+
+#ifndef SRC_SDI12SCHEDULER_H_
+#define SRC_SDI12SCHEDULER_H_
+
+#include "SDI12.h"
+
+#ifndef SDI12_SCHEDULER_MAX_SENSORS
+/**
+ * @brief The maximum number of sensor addresses the scheduler can track.
+ *
+ * Each tracked sensor costs ~10 bytes of RAM.  SDI-12 allows up to 62 addresses on a
+ * bus; raise this define if you really have more than 8 sensors on one pin.
+ */
+#define SDI12_SCHEDULER_MAX_SENSORS 8
+#endif
+
+/**
+ * @brief The number of parsed values handed to the data handler at a time.
+ *
+ * A single D command response carries at most 75 characters of values; with a minimum
+ * of 2 characters per value (sign + 1 digit) and a practical maximum of 10 values per
+ * response, a 10-float scratch array covers any single response.
+ */
+#define SDI12_SCHEDULER_VALUE_CHUNK 10
+
+/**
+ * @brief A user callback receiving parsed measurement values.
+ *
+ * The handler may be called more than once per sensor per measurement cycle - once
+ * for each aD0!-aD9! response - with the values parsed from that response.
+ *
+ * @param address The address of the sensor the values came from
+ * @param values The parsed values
+ * @param count The number of values in the array
+ */
+typedef void (*SDI12DataHandler)(char address, float* values, uint8_t count);
+
+/**
+ * @brief A scheduler that overlaps concurrent measurements (aC!) across all
+ * registered sensors on a single SDI-12 bus.
+ *
+ * Started serially, a bus of N sensors takes the *sum* of the sensors' measurement
+ * times per cycle.  Because the aC! concurrent measurement command lets every sensor
+ * integrate at the same time, the same cycle takes only as long as the *slowest*
+ * sensor.  This class packages the bookkeeping that sketches (eg,
+ * extras/TestCommands) previously hand-rolled with parallel arrays:
+ *
+ * @code{.cpp}
+ *     SDI12Scheduler scheduler(mySDI12);
+ *     scheduler.addAddress('1');
+ *     scheduler.addAddress('2');
+ *     scheduler.setDataHandler(recordValues);
+ *     scheduler.startMeasurements();
+ *     while (scheduler.poll()) { doOtherWork(); }
+ * @endcode
+ *
+ * SDI12Scheduler::startMeasurements() issues aC! to each sensor and parses the
+ * `atttnn` reply for the wait time and value count.  SDI12Scheduler::poll() then
+ * fires the aD0!...aD9! retrievals as each sensor's wait time matures, parsing the
+ * values and delivering them through the data handler.
+ */
+class SDI12Scheduler {
+ public:
+  /**
+   * @brief The measurement-cycle state of one tracked sensor.
+   */
+  typedef enum SDI12_SENSOR_STATES {
+    /** No measurement has been started on this sensor */
+    SDI12_SENSOR_IDLE,
+    /** A concurrent measurement is integrating; data is not yet ready */
+    SDI12_SENSOR_MEASURING,
+    /** All expected values have been retrieved and delivered */
+    SDI12_SENSOR_DONE,
+    /** The sensor did not respond, or returned fewer values than promised */
+    SDI12_SENSOR_FAILED
+  } SDI12_SENSOR_STATES;
+
+  /**
+   * @brief Construct a new scheduler bound to an SDI-12 bus.
+   *
+   * @param bus The SDI12 instance for the bus the sensors are on
+   */
+  explicit SDI12Scheduler(SDI12& bus);
+
+  /**
+   * @brief Register a sensor address with the scheduler.
+   *
+   * @param address The single-character sensor address ('0'-'9', 'a'-'z', 'A'-'Z')
+   * @return True if the address was added; false if it was already registered or the
+   * scheduler is full (see #SDI12_SCHEDULER_MAX_SENSORS).
+   */
+  bool addAddress(char address);
+  /**
+   * @brief Remove all registered addresses and reset all sensor states.
+   */
+  void clearAddresses();
+
+  /**
+   * @brief Set the callback that receives parsed measurement values.
+   *
+   * @param handler The function to call; pass nullptr to remove a handler.
+   */
+  void setDataHandler(SDI12DataHandler handler);
+
+  /**
+   * @brief Start a concurrent measurement (aC!) on every registered sensor.
+   *
+   * This issues aC! (or aCC! when a CRC is requested) to each sensor in turn and
+   * parses the wait time and expected value count from each reply.  It blocks for the
+   * command/response exchanges themselves (tens of milliseconds per sensor) but *not*
+   * for the measurement times - all sensors integrate simultaneously afterwards.
+   *
+   * @param requestCRC True to issue aCC! so the sensors append a CRC to their data
+   * responses.  Note that the scheduler's streaming parser skips rather than verifies
+   * the CRC characters.
+   * @return The number of sensors that acknowledged the measurement command.
+   */
+  uint8_t startMeasurements(bool requestCRC = false);
+
+  /**
+   * @brief Service the measurement cycle; call this frequently from the main loop.
+   *
+   * If a sensor's wait time has matured, its data is retrieved with aD0!...aD9!
+   * commands, parsed, and delivered through the data handler.  To keep the caller's
+   * loop latency bounded, at most one sensor is serviced per call.
+   *
+   * @return The number of sensors still measuring (0 when the cycle is complete).
+   */
+  uint8_t poll();
+
+  /**
+   * @brief Check whether any registered sensor is still mid-measurement, without
+   * servicing any sensors.
+   *
+   * @return True if a call to poll() is still needed to finish the cycle.
+   */
+  bool busy();
+
+  /**
+   * @brief Get the measurement-cycle state of a sensor.
+   *
+   * @param address The sensor address
+   * @return The sensor's #SDI12_SENSOR_STATES value, or #SDI12_SENSOR_FAILED for an
+   * address that was never registered.
+   */
+  SDI12_SENSOR_STATES sensorState(char address);
+
+ private:
+  /**
+   * @brief The scheduler's per-sensor bookkeeping record.
+   */
+  typedef struct SDI12SensorSlot {
+    /** The sensor's address character */
+    char address;
+    /** The sensor's #SDI12_SENSOR_STATES value */
+    uint8_t state;
+    /** The millis() count at which the sensor's data will be ready */
+    uint32_t millisReady;
+    /** The number of values the sensor promised in its aC! reply */
+    uint8_t expectedResults;
+    /** The number of values retrieved and delivered so far */
+    uint8_t returnedResults;
+    /** The digit of the next aD_! command to issue (0-9) */
+    uint8_t dCommand;
+  } SDI12SensorSlot;
+
+  /**
+   * @brief Find the slot index for an address.
+   *
+   * @param address The sensor address
+   * @return The slot index, or -1 if the address is not registered.
+   */
+  int8_t indexOf(char address);
+  /**
+   * @brief Retrieve a matured sensor's data with aD0!...aD9! and deliver the parsed
+   * values through the data handler.
+   *
+   * @param slot The sensor's bookkeeping record
+   */
+  void retrieve(SDI12SensorSlot& slot);
+
+  /** The SDI-12 bus the scheduler talks on */
+  SDI12* _bus;
+  /** The per-sensor bookkeeping records */
+  SDI12SensorSlot _sensors[SDI12_SCHEDULER_MAX_SENSORS];
+  /** The number of registered sensors */
+  uint8_t _sensorCount = 0;
+  /** True if the current cycle was started with a CRC request */
+  bool _requestCRC = false;
+  /** The user's data callback */
+  SDI12DataHandler _dataHandler = nullptr;
+};
+
+#endif  // SRC_SDI12SCHEDULER_H_
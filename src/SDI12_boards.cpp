@@ -18,29 +18,9 @@ sensors. This library provides a general software solution, without requiring
 
 SDI12Timer::SDI12Timer() {}
 
-uint16_t SDI12Timer::mul8x8to16(uint8_t x, uint8_t y) {
-  return x * y;
-}
-
-// Using an 8-bit timer, we need to do fanciness to get proper 16 bit results
-#if TIMER_INT_SIZE == 8
-uint16_t SDI12Timer::bitTimes(sdi12timer_t dt) {
-  // multiply the time delta in ticks by the bits per tick
-  return mul8x8to16(dt + static_cast<uint8_t>(RX_WINDOW_FUDGE),
-                    static_cast<uint8_t>(BITS_PER_TICK_Q10)) >>
-    10;
-}
-
-// But nothing fancy for bigger timers
-#elif TIMER_INT_SIZE == 16 || TIMER_INT_SIZE == 32
-uint16_t SDI12Timer::bitTimes(sdi12timer_t dt) {
-  // divide the number of ticks by the ticks per bit
-  return static_cast<uint16_t>((dt + static_cast<sdi12timer_t>(RX_WINDOW_FUDGE)) /
-                               static_cast<sdi12timer_t>(TICKS_PER_BIT));
-}
-#else
-#error "Board timer is incorrectly configured!"
-#endif
+// bitTimes() now lives in the header as an inline wrapper over the board's
+// SDI12TimerPolicy, so the Q10-versus-division choice and all of the constants are
+// folded at compile time.
 
 
 // Most 'standard' AVR boards
@@ -49,6 +29,63 @@ uint16_t SDI12Timer::bitTimes(sdi12timer_t dt) {
   defined(__AVR_ATmega644P__) || defined(__AVR_ATmega644__) ||   \
   defined(__AVR_ATmega1284P__) || defined(__AVR_ATmega1284__)
 
+#if defined(SDI12_USE_INPUT_CAPTURE)
+
+/**
+ * @brief The value of timer control register 1A prior to being set for SDI-12.
+ */
+static uint8_t preSDI12_TCCR1A;
+/**
+ * @brief The value of timer control register 1B prior to being set for SDI-12.
+ */
+static uint8_t preSDI12_TCCR1B;
+/**
+ * @brief The value of timer interrupt mask register 1 prior to being set for SDI-12.
+ */
+static uint8_t preSDI12_TIMSK1;
+
+sdi12timer_t SDI12Timer::SDI12TimerRead(void) {
+  return TCNT1;
+}
+
+void SDI12Timer::configSDI12TimerPrescale(void) {
+  preSDI12_TCCR1A = TCCR1A;
+  preSDI12_TCCR1B = TCCR1B;
+  preSDI12_TIMSK1 = TIMSK1;
+  TCCR1A = 0x00;  // TCCR1A = 0x00 = "normal" operation - Normal port operation, OC1A &
+                  // OC1B disconnected
+  // Enable the input capture noise canceler (4-cycle glitch filter), capture on the
+  // rising edge to start with, and set the prescaler to CK/256.  The capture and
+  // compare interrupts themselves stay masked until the line enters the listening or
+  // transmitting states.
+  TCCR1B = (1 << ICNC1) | (1 << ICES1) | (1 << CS12);
+  TIMSK1 &= ~((1 << ICIE1) | (1 << OCIE1A));
+}
+
+void SDI12Timer::resetSDI12TimerPrescale(void) {
+  TCCR1A = preSDI12_TCCR1A;
+  TCCR1B = preSDI12_TCCR1B;
+  TIMSK1 = preSDI12_TIMSK1;
+}
+
+void SDI12Timer::startBitInterrupt(void) {
+  OCR1A = static_cast<uint16_t>(TCNT1 + TICKS_PER_BIT);  // first match one bit from now
+  TIFR1 = (1 << OCF1A);     // clear any stale compare match flag (write 1 to clear)
+  TIMSK1 |= (1 << OCIE1A);  // enable the output compare match A interrupt
+}
+
+void SDI12Timer::nextBitInterrupt(void) {
+  // Advance the match point relative to the *previous* match so interrupt service
+  // latency cannot accumulate into bit-timing drift.
+  OCR1A = static_cast<uint16_t>(OCR1A + TICKS_PER_BIT);
+}
+
+void SDI12Timer::stopBitInterrupt(void) {
+  TIMSK1 &= ~(1 << OCIE1A);  // disable the output compare match A interrupt
+}
+
+#else  // SDI12_USE_INPUT_CAPTURE
+
 /**
  * @brief The value of timer control register 2A prior to being set for SDI-12.
  */
@@ -88,6 +125,24 @@ void SDI12Timer::resetSDI12TimerPrescale(void) {
   TCCR2B = preSDI12_TCCR2B;
 }
 
+void SDI12Timer::startBitInterrupt(void) {
+  OCR2A = static_cast<uint8_t>(TCNT2 + TICKS_PER_BIT);  // first match one bit from now
+  TIFR2 = (1 << OCF2A);     // clear any stale compare match flag (write 1 to clear)
+  TIMSK2 |= (1 << OCIE2A);  // enable the output compare match A interrupt
+}
+
+void SDI12Timer::nextBitInterrupt(void) {
+  // Advance the match point relative to the *previous* match so interrupt service
+  // latency cannot accumulate into bit-timing drift.
+  OCR2A = static_cast<uint8_t>(OCR2A + TICKS_PER_BIT);
+}
+
+void SDI12Timer::stopBitInterrupt(void) {
+  TIMSK2 &= ~(1 << OCIE2A);  // disable the output compare match A interrupt
+}
+
+#endif  // SDI12_USE_INPUT_CAPTURE
+
 // ATtiny boards (ie, adafruit trinket)
 #elif defined(__AVR_ATtiny25__) | defined(__AVR_ATtiny45__) | defined(__AVR_ATtiny85__)
 
@@ -305,6 +360,30 @@ void SDI12Timer::resetSDI12TimerPrescale(void) {
   while (GCLK->STATUS.bit.SYNCBUSY);  // Wait for synchronization
 }
 
+void SDI12Timer::startBitInterrupt(void) {
+  // Set compare channel 0 to match one bit time from now
+  SDI12_TC->COUNT16.CC[0].reg = static_cast<uint16_t>(REG_TC3_COUNT16_COUNT +
+                                                      TICKS_PER_BIT);
+  while (SDI12_TC->COUNT16.STATUS.bit.SYNCBUSY);  // Wait for synchronization
+  SDI12_TC->COUNT16.INTFLAG.reg  = TC_INTFLAG_MC0;   // clear a stale match flag
+  SDI12_TC->COUNT16.INTENSET.reg = TC_INTENSET_MC0;  // enable the match 0 interrupt
+  NVIC_ClearPendingIRQ(SDI12_TC_IRQn);
+  NVIC_EnableIRQ(SDI12_TC_IRQn);
+}
+
+void SDI12Timer::nextBitInterrupt(void) {
+  // Advance the match point relative to the *previous* match so interrupt service
+  // latency cannot accumulate into bit-timing drift.
+  SDI12_TC->COUNT16.CC[0].reg = static_cast<uint16_t>(SDI12_TC->COUNT16.CC[0].reg +
+                                                      TICKS_PER_BIT);
+  while (SDI12_TC->COUNT16.STATUS.bit.SYNCBUSY);  // Wait for synchronization
+}
+
+void SDI12Timer::stopBitInterrupt(void) {
+  SDI12_TC->COUNT16.INTENCLR.reg = TC_INTENCLR_MC0;  // disable the match 0 interrupt
+  NVIC_DisableIRQ(SDI12_TC_IRQn);
+}
+
 // SAMD51 and SAME51 boards
 #elif defined(__SAMD51__) || defined(__SAME51__)
 
@@ -521,6 +600,30 @@ void SDI12Timer::resetSDI12TimerPrescale(void) {
   while (GCLK->SYNCBUSY.reg & GCLK_SYNCBUSY_SDI12);  // Wait for the SDI-12 clock
 }
 
+void SDI12Timer::startBitInterrupt(void) {
+  // Set compare channel 0 to match one bit time from now
+  SDI12_TC->COUNT16.CC[0].reg = static_cast<uint16_t>(SDI12TimerRead() +
+                                                      TICKS_PER_BIT);
+  while (SDI12_TC->COUNT16.SYNCBUSY.bit.CC0);        // wait for the CC0 write to sync
+  SDI12_TC->COUNT16.INTFLAG.reg  = TC_INTFLAG_MC0;   // clear a stale match flag
+  SDI12_TC->COUNT16.INTENSET.reg = TC_INTENSET_MC0;  // enable the match 0 interrupt
+  NVIC_ClearPendingIRQ(SDI12_TC_IRQn);
+  NVIC_EnableIRQ(SDI12_TC_IRQn);
+}
+
+void SDI12Timer::nextBitInterrupt(void) {
+  // Advance the match point relative to the *previous* match so interrupt service
+  // latency cannot accumulate into bit-timing drift.
+  SDI12_TC->COUNT16.CC[0].reg = static_cast<uint16_t>(SDI12_TC->COUNT16.CC[0].reg +
+                                                      TICKS_PER_BIT);
+  while (SDI12_TC->COUNT16.SYNCBUSY.bit.CC0);  // wait for the CC0 write to sync
+}
+
+void SDI12Timer::stopBitInterrupt(void) {
+  SDI12_TC->COUNT16.INTENCLR.reg = TC_INTENCLR_MC0;  // disable the match 0 interrupt
+  NVIC_DisableIRQ(SDI12_TC_IRQn);
+}
+
 // Espressif ESP32/ESP8266 boards, Particle boards, or any boards faster than 48MHz not
 // mentioned above
 // WARNING: I haven't tested the minimum speed that this will work at!
@@ -54,13 +54,31 @@ sensors. This library provides a general software solution, without requiring
  * @brief The number of "ticks" of the timer that occur within the timing of one bit at
  * the SDI-12 baud rate of 1200 bits/second.
  *
+ * Derived from the board's ::SDI12TimerPolicy; kept as a macro name for
+ * compatibility.
+ *
  * @def BITS_PER_TICK_Q10
  * @brief The number of "ticks" of the timer per SDI-12 bit, shifted by 2^10.
  *
+ * Derived from the board's ::SDI12TimerPolicy; kept as a macro name for
+ * compatibility.
+ *
  * @def RX_WINDOW_FUDGE
  * @brief A "fudge factor" to get the Rx to work well. It mostly works to ensure that
  * uneven tick increments get rounded up.
  *
+ * Derived from the board's ::SDI12TimerPolicy; kept as a macro name for
+ * compatibility.
+ *
+ * @def SDI12_TIMER_COMPARE
+ * @brief Defined for boards whose SDI-12 timer has a free output-compare channel that
+ * this library can use to clock outgoing bits from an interrupt.
+ *
+ * On boards where this is defined, SDI12::beginCommand() can transmit asynchronously
+ * using a compare-match interrupt on the same timer used for Rx bit timing.  On boards
+ * without a usable compare channel the asynchronous functions fall back to the
+ * blocking send path.
+ *
  * @see https://github.com/SlashDevin/NeoSWSerial/pull/13
  */
 
@@ -71,12 +89,58 @@ sensors. This library provides a general software solution, without requiring
   defined(__AVR_ATmega644P__) || defined(__AVR_ATmega644__) ||   \
   defined(__AVR_ATmega1284P__) || defined(__AVR_ATmega1284__)
 
+#if defined(SDI12_USE_INPUT_CAPTURE)
+/**
+ * The input-capture Rx backend uses Timer/Counter 1's input capture unit (ICP1)
+ * instead of a pin-change interrupt.  The edge timestamp is latched into ICR1 *in
+ * hardware* at the moment of the transition, so interrupt service latency - from the
+ * millis() tick, radio stacks, or this library's own transmit bit clock - no longer
+ * jitters the measured bit times, and the RX_WINDOW_FUDGE margin can be much smaller.
+ *
+ * The data pin MUST be the ICP1 pin for this backend (Arduino pin 8 on
+ * Uno/Mayfly-class ATmega328P/1284P boards - consult your board's pinout for ICP1).
+ * Note that Timer1 is also claimed by the Servo library.
+ */
+#define TIMER_IN_USE_STR "Timer1-ICP"
+// Timer 1 is a 16-bit timer
+#define TIMER_INT_TYPE uint16_t
+#define TIMER_INT_SIZE 16
+#define READTIME TCNT1
+/// The register holding the hardware-latched edge timestamp
+#define SDI12_CAPTURE_REG ICR1
+// Timer 1's output compare channel A is free for the outgoing bit clock
+#define SDI12_TIMER_COMPARE
+
+#if F_CPU == 16000000L
+#define PRESCALE_IN_USE 256
+#define PRESCALE_IN_USE_STR "16MHz/256=62.5kHz"
+// 16MHz / 256 prescaler = 62500 'ticks'/sec = 16 µs / 'tick'
+#define TICKS_PER_SECOND 62500
+
+#elif F_CPU == 12000000L
+#define PRESCALE_IN_USE 256
+#define PRESCALE_IN_USE_STR "12MHz/256=46.9kHz"
+// 12MHz / 256 prescaler = 46875 'ticks'/sec = 21.33 µs / 'tick'
+#define TICKS_PER_SECOND 46875
+
+#elif F_CPU == 8000000L
+#define PRESCALE_IN_USE 256
+#define PRESCALE_IN_USE_STR "8MHz/256=31.25kHz"
+// 8MHz / 256 prescaler = 31250 'ticks'/sec = 32 µs / 'tick'
+#define TICKS_PER_SECOND 31250
+
+#endif  // F_CPU
+
+#else  // SDI12_USE_INPUT_CAPTURE
+
 // Use Timer/Counter 2 on most AVR boards
 #define TIMER_IN_USE_STR "Timer2"
 // Timer 2 on AtMega boards is an 8-bit timer
 #define TIMER_INT_TYPE uint8_t
 #define TIMER_INT_SIZE 8
 #define READTIME TCNT2
+// Timer 2's output compare channel A is free once this library has taken the timer
+#define SDI12_TIMER_COMPARE
 
 #if F_CPU == 16000000L
 #define PRESCALE_IN_USE 1024
@@ -98,6 +162,11 @@ sensors. This library provides a general software solution, without requiring
 
 #endif  // F_CPU
 
+#endif  // SDI12_USE_INPUT_CAPTURE
+
+#elif defined(SDI12_USE_INPUT_CAPTURE)
+#error "The input-capture Rx backend is only supported on standard AVR boards!"
+
 
 // ATtiny boards (ie, adafruit trinket)
 #elif defined(__AVR_ATtiny25__) | defined(__AVR_ATtiny45__) | defined(__AVR_ATtiny85__)
@@ -172,6 +241,10 @@ sensors. This library provides a general software solution, without requiring
 // This signifies the register of timer/counter 3, the 16-bit count, the count value
 // This is equivalent to TC3->COUNT16.COUNT.reg
 #define READTIME REG_TC3_COUNT16_COUNT
+// TC3's compare/capture channel 0 is free for the outgoing bit clock
+#define SDI12_TIMER_COMPARE
+/// The interrupt request number for the selected timer controller
+#define SDI12_TC_IRQn TC3_IRQn
 
 #define PRESCALE_IN_USE 96
 #define PRESCALE_IN_USE_STR "48MHz/6/16=500kHz"
@@ -203,6 +276,10 @@ sensors. This library provides a general software solution, without requiring
 // sync bit, waiting, and then reading the register.  Because of the steps, we need a
 // function.
 #define READTIME sdi12timer.SDI12TimerRead()
+// TC2's compare/capture channel 0 is free for the outgoing bit clock
+#define SDI12_TIMER_COMPARE
+/// The interrupt request number for the selected timer controller
+#define SDI12_TC_IRQn TC2_IRQn
 
 #define PRESCALE_IN_USE 240
 #define PRESCALE_IN_USE_STR "120MHz/15/16=500kHz"
@@ -239,89 +316,206 @@ sensors. This library provides a general software solution, without requiring
 #endif
 
 
-#if TICKS_PER_SECOND == 15625 && TIMER_INT_SIZE == 8
 /**
- * 15625 'ticks'/sec = 64 µs / 'tick'
- * (1 sec/1200 bits) * (1 tick/64 µs) = 13.0208 ticks/bit
+ * @brief Maps a counter size in bits to the narrowest unsigned integer type that
+ * holds it, so a timer policy automatically picks the right counter width.
  *
- * The 8-bit timer rolls over after 256 ticks, 19.66085 bits, or 16.38505 ms
- * (256 ticks/roll-over) * (1 bit/13.0208 ticks) = 19.66085 bits
- * (256 ticks/roll-over) * (1 sec/15625 ticks) = 16.38505 milliseconds
+ * @tparam Bits The counter size: 8, 16, or 32.
  */
-#define TICKS_PER_BIT 13
+template <uint8_t Bits>
+struct SDI12CounterType;
+/// @copydoc SDI12CounterType
+template <>
+struct SDI12CounterType<8> {
+  typedef uint8_t type;  ///< an 8-bit counter
+};
+/// @copydoc SDI12CounterType
+template <>
+struct SDI12CounterType<16> {
+  typedef uint16_t type;  ///< a 16-bit counter
+};
+/// @copydoc SDI12CounterType
+template <>
+struct SDI12CounterType<32> {
+  typedef uint32_t type;  ///< a 32-bit counter
+};
+
 /**
- * 1/(13.0208 ticks/bit) * 2^10 = 78.6432
+ * @brief The common implementation behind every timer policy: all of the per-board
+ * bit-timing arithmetic, evaluated at compile time.
+ *
+ * @tparam TicksPerSecond_ The tick rate of the counter after prescaling.
+ * @tparam IntSize_ The counter size in bits (8, 16, or 32).
+ * @tparam TicksPerBit_ The (truncated or rounded, per the board's tuning) number of
+ * ticks in one bit time at 1200 baud.
+ * @tparam RxWindowFudge_ The fudge added to each measured gap before conversion, to
+ * round uneven tick increments up and absorb interrupt latency.
+ *
+ * The rollover-per-character hazard that used to be a hand-maintained comment in the
+ * macro cascade is checked here with a static_assert: a configuration whose counter
+ * rolls over faster than a character frame fails to compile instead of silently
+ * mis-decoding.  The borderline 8-bit/31250Hz case (9.83 bits per rollover) is still
+ * accepted and flagged with #rollsOverWithinChar, which the receive ISR uses - as a
+ * compile-time constant, so the branch folds away - to skip the too-close-together
+ * edge check that rollover would falsify.
  */
-#define BITS_PER_TICK_Q10 79
-#define RX_WINDOW_FUDGE 2
+template <uint32_t TicksPerSecond_, uint8_t IntSize_, uint32_t TicksPerBit_,
+          uint16_t RxWindowFudge_>
+struct SDI12TimerPolicyBase {
+  /// The counter type, picked automatically from the counter size
+  typedef typename SDI12CounterType<IntSize_>::type counter_t;
+  /// The tick rate of the counter after prescaling
+  static constexpr uint32_t ticksPerSecond = TicksPerSecond_;
+  /// The counter size in bits
+  static constexpr uint8_t intSize = IntSize_;
+  /// The number of ticks in one bit time at 1200 baud
+  static constexpr uint32_t ticksPerBit = TicksPerBit_;
+  /// The fudge added to each measured gap before conversion to bit times
+  static constexpr uint16_t rxWindowFudge = RxWindowFudge_;
+  /// The number of bit times per tick in Q10 fixed point (ie, shifted up by 2^10),
+  /// rounded to nearest: (1200 bits/sec / ticksPerSecond) * 2^10
+  static constexpr uint16_t bitsPerTickQ10 =
+    static_cast<uint16_t>((1024UL * 1200UL + TicksPerSecond_ / 2) / TicksPerSecond_);
+  /// How many full bit times fit in one counter rollover
+  static constexpr uint32_t bitsPerRollover =
+    static_cast<uint32_t>(static_cast<counter_t>(-1)) / TicksPerBit_;
+  /// True when the counter can roll over within a single 10-bit character frame, in
+  /// which case gaps measured across a whole character cannot be trusted
+  static constexpr bool rollsOverWithinChar = bitsPerRollover < 10;
+
+  static_assert(TicksPerBit_ >= 4,
+                "Fewer than 4 timer ticks per bit cannot resolve SDI-12 bit edges; "
+                "use a smaller prescale.");
+  static_assert(static_cast<uint32_t>(static_cast<counter_t>(-1)) / TicksPerBit_ >= 9,
+                "The timer rolls over faster than one SDI-12 character frame; use a "
+                "smaller prescale or a wider counter.");
+
+  /**
+   * @brief The number of bit times at 1200 baud in a measured tick gap.
+   *
+   * @param dt The gap between two edges, in ticks.
+   * @return The number of bit times in the gap.
+   *
+   * On 8-bit counters a divide is expensive, so the gap is converted with the Q10
+   * multiply-and-shift; on wider counters the division by a compile-time constant is
+   * strength-reduced (or, after inlining a constant, folded entirely) by the
+   * compiler.  The selection is made on a template constant, so only one branch
+   * survives in the generated code.
+   */
+  static constexpr uint16_t bitTimes(counter_t dt) {
+    return (IntSize_ == 8)
+      ? static_cast<uint16_t>(
+          (static_cast<uint16_t>(static_cast<uint8_t>(dt + RxWindowFudge_)) *
+           bitsPerTickQ10) >>
+          10)
+      : static_cast<uint16_t>((static_cast<uint32_t>(dt) + RxWindowFudge_) /
+                              TicksPerBit_);
+  }
+};
 
-#elif TICKS_PER_SECOND == 11719 && TIMER_INT_SIZE == 8
 /**
- * 11719 'ticks'/sec = 85 µs / 'tick'
- * (1 sec/1200 bits) * (1 tick/85 µs) = 9.765625 ticks/bit
+ * @brief The timer policy for one (tick rate, counter size) configuration.
  *
- * The 8-bit timer rolls over after 256 ticks, 26.2144 bits, or 21.84487 ms
- * (256 ticks/roll-over) * (1 bit/9.765625 ticks) = 26.2144 bits
- * (256 ticks/roll-over) * (1 sec/11719 ticks) = 21.84487 milliseconds
+ * @tparam TicksPerSecond_ The tick rate of the counter after prescaling.
+ * @tparam IntSize_ The counter size in bits.
+ *
+ * Each supported configuration is one specialization line below, carrying the
+ * board-tuned ticks-per-bit and receive-window fudge; everything else is derived in
+ * SDI12TimerPolicyBase.  Bringing up a new board means adding its hardware block to
+ * the cascade above and, if its tick rate is new, one specialization line here.
  */
-#define TICKS_PER_BIT 10
+template <uint32_t TicksPerSecond_, uint8_t IntSize_>
+struct SDI12TimerPolicy {
+  static_assert(TicksPerSecond_ != TicksPerSecond_,
+                "No SDI12TimerPolicy specialization for this tick rate and counter "
+                "size; add one line deriving from SDI12TimerPolicyBase.");
+};
+
 /**
- * 1/(9.765625 ticks/bit) * 2^10 = 104.8576
+ * 15625 'ticks'/sec = 64 µs / 'tick'
+ * (1 sec/1200 bits) * (1 tick/64 µs) = 13.0208 ticks/bit
+ * The 8-bit timer rolls over after 256 ticks, 19.66085 bits, or 16.38505 ms
  */
-#define BITS_PER_TICK_Q10 105
-#define RX_WINDOW_FUDGE 2
+template <>
+struct SDI12TimerPolicy<15625, 8> : SDI12TimerPolicyBase<15625, 8, 13, 2> {};
+
+/**
+ * 11719 'ticks'/sec = 85 µs / 'tick'
+ * (1 sec/1200 bits) * (1 tick/85 µs) = 9.765625 ticks/bit
+ * The 8-bit timer rolls over after 256 ticks, 26.2144 bits, or 21.84487 ms
+ */
+template <>
+struct SDI12TimerPolicy<11719, 8> : SDI12TimerPolicyBase<11719, 8, 10, 2> {};
 
-#elif TICKS_PER_SECOND == 31250 && TIMER_INT_SIZE == 8
 /**
  * 31250 'ticks'/sec = 32 µs / 'tick'
  * (1 sec/1200 bits) * (1 tick/32 µs) = 26.04166667 ticks/bit
- *
  * The 8-bit timer rolls over after 256 ticks, 9.8304 bits, or 8.192 ms
- * (256 ticks/roll-over) * (1 bit/26.04166667 ticks) = 9.8304 bits
- * (256 ticks/roll-over) * (1 sec/31250 ticks) = 8.192 milliseconds
  * @note The timer will roll-over with each character!
  */
-#define TICKS_PER_BIT 26
+template <>
+struct SDI12TimerPolicy<31250, 8> : SDI12TimerPolicyBase<31250, 8, 26, 10> {};
+
 /**
- * 1/(26.04166667 ticks/bit) * 2^10 = 39.3216
+ * 62500 'ticks'/sec = 16 µs / 'tick'
+ * (1 sec/1200 bits) * (1 tick/16 µs) = 52.0833 ticks/bit
+ * The 16-bit timer rolls over after 65536 ticks, 1258.3 bits, or 1.049 seconds
+ *
+ * The timestamps come from the hardware input capture unit, so there is no interrupt
+ * latency to pad for - the fudge only covers tick truncation.
  */
-#define BITS_PER_TICK_Q10 39
-#define RX_WINDOW_FUDGE 10
+template <>
+struct SDI12TimerPolicy<62500, 16> : SDI12TimerPolicyBase<62500, 16, 52, 2> {};
 
+/**
+ * 46875 'ticks'/sec = 21.33 µs / 'tick'
+ * (1 sec/1200 bits) * (1 tick/21.33 µs) = 39.0625 ticks/bit
+ * The 16-bit timer rolls over after 65536 ticks, 1677.7 bits, or 1.398 seconds
+ */
+template <>
+struct SDI12TimerPolicy<46875, 16> : SDI12TimerPolicyBase<46875, 16, 39, 2> {};
+
+/**
+ * 31250 'ticks'/sec = 32 µs / 'tick'
+ * (1 sec/1200 bits) * (1 tick/32 µs) = 26.04166667 ticks/bit
+ * The 16-bit timer rolls over after 65536 ticks, 2516.6 bits, or 2.097 seconds -
+ * unlike the 8-bit Timer2 configuration at this tick rate, there is no roll-over
+ * within a character.
+ */
+template <>
+struct SDI12TimerPolicy<31250, 16> : SDI12TimerPolicyBase<31250, 16, 26, 2> {};
 
-#elif TICKS_PER_SECOND == 500000 && TIMER_INT_SIZE == 16
 /**
  * 500kHz = 500,000 'ticks'/sec = 2 µs / 'tick'
  * (1 sec/1200 bits) * (1 tick/2 µs) = 416.66667 ticks/bit
- *
  * The 16-bit timer rolls over after 65536 ticks, 157.284 bits, or 131.07 ms
- * (65536 ticks/roll-over) * (1 bit/416.66667 ticks) = 157.284 bits
- * (65536 ticks/roll-over) * (1 sec/500000 ticks) = 131.07 milliseconds
  */
-#define TICKS_PER_BIT 416
-#define RX_WINDOW_FUDGE 30
+template <>
+struct SDI12TimerPolicy<500000, 16> : SDI12TimerPolicyBase<500000, 16, 416, 30> {};
 
-#elif TICKS_PER_SECOND == 1000000 && TIMER_INT_SIZE == 32
 /**
  * Using `micros()` 1 "tick" is 1 µsec
  * (1 sec/1200 bits) * (1 tick/1 µs) * (1000000 µsec/sec)= 833.33333 ticks/bit
- *
  * The 32-bit timer rolls over after 4294967296 ticks, or 4294.9673 seconds
+ *
+ * The fudge is larger at exactly 48MHz, based on testing in
+ * https://github.com/EnviroDIY/Arduino-SDI-12/issues/145
  */
-#define TICKS_PER_BIT 833UL
-#if F_CPU == 48000000L
-#define RX_WINDOW_FUDGE 95
-#else
-#define RX_WINDOW_FUDGE 50
-#endif
-
-#else
-#error "Board timer is incorrectly configured!"
-#endif
+template <>
+struct SDI12TimerPolicy<1000000, 32>
+    : SDI12TimerPolicyBase<1000000, 32, 833, (F_CPU == 48000000L ? 95 : 50)> {};
 
+/** The timer policy for the board configuration selected above */
+typedef SDI12TimerPolicy<TICKS_PER_SECOND, TIMER_INT_SIZE> SDI12BoardTimerPolicy;
 
 /** The integer type (size) of the timer return value */
-typedef TIMER_INT_TYPE sdi12timer_t;
+typedef SDI12BoardTimerPolicy::counter_t sdi12timer_t;
+
+// The legacy macro names, now derived from the policy so that existing code (and any
+// user sketches that referenced them) keeps compiling unchanged.
+#define TICKS_PER_BIT (SDI12BoardTimerPolicy::ticksPerBit)
+#define BITS_PER_TICK_Q10 (SDI12BoardTimerPolicy::bitsPerTickQ10)
+#define RX_WINDOW_FUDGE (SDI12BoardTimerPolicy::rxWindowFudge)
 
 /**
  * @brief The class used to define the processor timer for the SDI-12 serial emulation.
@@ -333,16 +527,6 @@ class SDI12Timer {
    */
   SDI12Timer();
 
-  /**
-   * @brief static method for getting a 16-bit value from the multiplication of 2 8-bit
-   * values
-   *
-   * @param x The first 8 bit integer
-   * @param y The second 8 bit integer
-   * @return The result of the multiplication, as a 16 bit integer.
-   */
-  static uint16_t mul8x8to16(uint8_t x, uint8_t y);
-
   /**
    * @brief static method for calculating the number of bit-times that have elapsed
    * between interrupts.
@@ -350,15 +534,15 @@ class SDI12Timer {
    * @param dt The current value of the timer
    * @return The number of bit times that have passed at 1200 baud.
    *
-   * Adds a rxWindowWidth fudge factor to the time difference to get the number of
-   * ticks, and then multiplies the fudged ticks by the number of bits per tick.  Uses
-   * the number of bits per tick shifted up by 2^10 and then shifts the result down by
-   * the same amount to compensate for the fact that the number of bits per tick is a
-   * decimal the timestamp is only an 8-bit integer.
+   * A thin wrapper over SDI12TimerPolicyBase::bitTimes() for the board's policy; the
+   * fudge, the Q10-versus-division strategy, and the constants are all resolved at
+   * compile time, so this inlines to a few instructions in the receive ISR.
    *
    * @see https://github.com/SlashDevin/NeoSWSerial/pull/13#issuecomment-315463522
    */
-  static uint16_t bitTimes(sdi12timer_t dt);
+  static uint16_t bitTimes(sdi12timer_t dt) {
+    return SDI12BoardTimerPolicy::bitTimes(dt);
+  }
 
   /**
    * @brief Set the processor timer prescaler such that the 10 bits of an SDI-12
@@ -376,6 +560,30 @@ class SDI12Timer {
    * @return **sdi12timer_t** The current timer value
    */
   sdi12timer_t SDI12TimerRead(void);
+
+#if defined(SDI12_TIMER_COMPARE) || defined(DOXYGEN)
+  /**
+   * @brief Arm the timer's output-compare channel to fire one bit time from now and
+   * enable the compare-match interrupt.
+   *
+   * The compare-match interrupt vector calls SDI12::handleTxBitInterrupt(), which
+   * clocks out the next bit of an asynchronous transmission.  Only available on boards
+   * where #SDI12_TIMER_COMPARE is defined.
+   */
+  void startBitInterrupt(void);
+  /**
+   * @brief Advance the output-compare register by exactly one bit time.
+   *
+   * Called from within the compare-match interrupt so that the bit clock stays
+   * drift-free; the new match point is relative to the previous match, not to the
+   * (jittery) time at which the interrupt was serviced.
+   */
+  void nextBitInterrupt(void);
+  /**
+   * @brief Disable the compare-match interrupt, stopping the outgoing bit clock.
+   */
+  void stopBitInterrupt(void);
+#endif
 };
 
 #endif  // SRC_SDI12_BOARDS_H_
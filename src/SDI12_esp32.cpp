@@ -0,0 +1,77 @@
+/**
+ * @file SDI12_esp32.cpp
+ * @copyright Stroud Water Research Center
+ * @license This library is published under the BSD-3 license.
+ * @author Kevin M.Smith <SDI12@ethosengineering.org>
+ *
+ * @brief This file implements the ESP32 hardware-UART physical-layer backend.
+ */
+
+#if defined(ESP32)
+
+#include "SDI12_esp32.h"
+#include "SDI12.h"  // for the break and marking durations
+
+void SDI12ESP32UART::begin(int8_t dataPin) {
+  _dataPin = dataPin;
+  // Receive on the data pin, transmit on the dedicated pin if there is one, and let
+  // the UART peripheral do the SDI-12 line inversion itself.
+  int8_t txPin = _txPin < 0 ? _dataPin : _txPin;
+  _serial.begin(1200, SERIAL_7E1, _dataPin, txPin, true);
+}
+
+void SDI12ESP32UART::end() {
+  _serial.end();
+}
+
+void SDI12ESP32UART::sendBreakAndCommand(const char* cmd, size_t len,
+                                         int8_t extraWakeTime) {
+  int8_t txPin = _txPin < 0 ? _dataPin : _txPin;
+
+  // The UART cannot hold a break for the required 12 ms, so take the transmit pin
+  // back and drive the wake sequence as a plain GPIO.  Timing here is not critical,
+  // just like in SDI12::wakeSensors().
+  _serial.end();
+  pinMode(txPin, OUTPUT);
+  digitalWrite(txPin, HIGH);  // break is HIGH
+  delayMicroseconds(
+    SDI12_LINE_BREAK_MICROS);  // Required break of 12 milliseconds (12,000 µs)
+  delayMicroseconds(extraWakeTime * 1000);  // allow the sensors to wake
+  digitalWrite(txPin, LOW);                 // marking is LOW
+  delayMicroseconds(
+    SDI12_LINE_MARK_MICROS);  // Required marking of 8.33 milliseconds (8,333 µs)
+
+  // Hand the pin back to the UART; re-beginning also clears any stale characters out
+  // of the receive FIFO.  The UART's inverted idle level is LOW, so re-attaching the
+  // transmitter seamlessly continues the marking.
+  _serial.begin(1200, SERIAL_7E1, _dataPin, txPin, true);
+  _serial.write(reinterpret_cast<const uint8_t*>(cmd), len);
+  _serial.flush();  // block until the last stop bit has been clocked out
+
+  if (_txPin < 0) {
+    // With the receiver and transmitter sharing one wire, the receiver hears the
+    // command we just sent; discard the echo so it is not mistaken for a response.
+    size_t   discarded = 0;
+    uint32_t startMs   = millis();
+    while (discarded < len && millis() - startMs < 20) {
+      if (_serial.available() > 0) {
+        _serial.read();
+        discarded++;
+      }
+    }
+  }
+}
+
+int SDI12ESP32UART::available() {
+  return _serial.available();
+}
+
+int SDI12ESP32UART::read() {
+  return _serial.read();
+}
+
+int SDI12ESP32UART::peek() {
+  return _serial.peek();
+}
+
+#endif  // defined(ESP32)
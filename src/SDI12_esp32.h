@@ -0,0 +1,92 @@
+/**
+ * @file SDI12_esp32.h
+ * @copyright Stroud Water Research Center
+ * @license This library is published under the BSD-3 license.
+ * @author Kevin M.Smith <SDI12@ethosengineering.org>
+ *
+ * @brief This file defines the ESP32 hardware-UART physical-layer backend.
+ */
+
+#ifndef SRC_SDI12_ESP32_H_
+#define SRC_SDI12_ESP32_H_
+
+#if defined(ESP32) || defined(DOXYGEN)
+
+#include <Arduino.h>
+#include "SDI12_phy.h"
+
+/**
+ * @brief An ::SDI12Phy backend that offloads SDI-12 framing to one of the ESP32's
+ * hardware UARTs.
+ *
+ * The ESP32's UARTs can frame 1200 baud 7E1 characters entirely in hardware and can
+ * invert both the transmit and receive signals, which matches SDI-12's inverse logic
+ * exactly.  With this backend attached, receiving a full 75-character response costs
+ * zero CPU interrupts (the UART FIFO and driver absorb the characters) instead of
+ * roughly two pin-change interrupts per bit, so heavy WiFi or Bluetooth interrupt
+ * load can no longer corrupt a frame by delaying the edge timestamps.
+ *
+ * The only thing the UART cannot do itself is the wake sequence, because a UART break
+ * cannot be held for the required 12 ms; the backend drives the pin as a plain GPIO
+ * for the break and marking, then hands the pin back to the UART for the command
+ * characters.
+ *
+ * Usage:
+ *
+ * @code{.cpp}
+ *     SDI12ESP32UART sdi12Phy(Serial1);
+ *     SDI12         mySDI12(SDI12_DATA_PIN);
+ *
+ *     void setup() {
+ *       mySDI12.setPhyBackend(&sdi12Phy);
+ *       mySDI12.begin();
+ *     }
+ * @endcode
+ *
+ * By default the UART's receiver and transmitter share the single SDI-12 data pin.
+ * Because the UART's transmit driver is push-pull rather than open-drain, sharing the
+ * wire directly requires the usual SDI-12 line-driver circuit between the processor
+ * and the bus (which a 3.3V board needs to talk to a 5V bus anyway).  For adapter
+ * boards that split the line into separate receive and transmit signals, pass the
+ * transmit pin as the second constructor argument.
+ */
+class SDI12ESP32UART : public SDI12Phy {
+ public:
+  /**
+   * @brief Construct the backend around a hardware serial port.
+   *
+   * @param serial The hardware serial port to use (eg, `Serial1`); the port must not
+   * be in use for anything else.
+   * @param txPin The pin wired to the transmit side of the line driver, for adapters
+   * with separate receive and transmit signals.  With the default of -1 the UART
+   * transmits and receives on the shared data pin.
+   */
+  explicit SDI12ESP32UART(HardwareSerial& serial, int8_t txPin = -1)
+    : _serial(serial), _txPin(txPin) {}
+
+  void begin(int8_t dataPin) override;
+  void end() override;
+  void sendBreakAndCommand(const char* cmd, size_t len,
+                           int8_t extraWakeTime) override;
+  int  available() override;
+  int  read() override;
+  int  peek() override;
+
+ private:
+  /**
+   * @brief The hardware serial port doing the framing.
+   */
+  HardwareSerial& _serial;
+  /**
+   * @brief The dedicated transmit pin, or -1 when transmitting on the data pin.
+   */
+  int8_t _txPin;
+  /**
+   * @brief The SDI-12 data (receive) pin.
+   */
+  int8_t _dataPin = -1;
+};
+
+#endif  // defined(ESP32) || defined(DOXYGEN)
+
+#endif  // SRC_SDI12_ESP32_H_
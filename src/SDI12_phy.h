@@ -0,0 +1,80 @@
+/**
+ * @file SDI12_phy.h
+ * @copyright Stroud Water Research Center
+ * @license This library is published under the BSD-3 license.
+ * @author Kevin M.Smith <SDI12@ethosengineering.org>
+ *
+ * @brief This file defines the interface for pluggable SDI-12 physical-layer
+ * backends.
+ */
+
+#ifndef SRC_SDI12_PHY_H_
+#define SRC_SDI12_PHY_H_
+
+#include <inttypes.h>
+#include <stddef.h>
+
+/**
+ * @brief The interface for a pluggable SDI-12 physical-layer (PHY) backend.
+ *
+ * By default the SDI12 class bit-bangs the line in software: a pin-change (or
+ * input-capture) interrupt reconstructs incoming characters and a spin-wait or
+ * timer-compare bit clock drives outgoing ones.  On processors with peripherals that
+ * can do 1200-baud 7E1 framing in hardware (eg, the ESP32's inverting-capable UARTs),
+ * a backend implementing this interface can take over the whole character layer -
+ * receiving a 75-character response then costs zero interrupts instead of ~2 edges
+ * per bit.
+ *
+ * Attach a backend with SDI12::setPhyBackend() *before* calling SDI12::begin().  When
+ * a backend is attached, the software interrupt machinery is bypassed entirely; the
+ * backend owns the data line.
+ *
+ * @see SDI12ESP32UART for the ESP32 hardware-UART implementation.
+ */
+class SDI12Phy {
+ public:
+  virtual ~SDI12Phy() {}
+
+  /**
+   * @brief Take ownership of the data line and prepare the hardware.
+   *
+   * @param dataPin The data pin's digital pin number
+   */
+  virtual void begin(int8_t dataPin) = 0;
+  /**
+   * @brief Release the data line and shut down the hardware.
+   */
+  virtual void end() = 0;
+  /**
+   * @brief Send the wake break, the marking, and a command, then return the line to
+   * receive mode.
+   *
+   * @param cmd The command characters (not null terminated; use `len`)
+   * @param len The number of characters in the command
+   * @param extraWakeTime The amount of additional time in milliseconds to extend the
+   * break to allow slow sensors to wake.
+   */
+  virtual void sendBreakAndCommand(const char* cmd, size_t len,
+                                   int8_t extraWakeTime) = 0;
+  /**
+   * @brief Return the number of received characters waiting to be read.
+   *
+   * @return The number of characters available
+   */
+  virtual int available() = 0;
+  /**
+   * @brief Return the next received character, consuming it; -1 if none is waiting.
+   *
+   * @return The next character, or -1
+   */
+  virtual int read() = 0;
+  /**
+   * @brief Return the next received character without consuming it; -1 if none is
+   * waiting.
+   *
+   * @return The next character, or -1
+   */
+  virtual int peek() = 0;
+};
+
+#endif  // SRC_SDI12_PHY_H_
@@ -0,0 +1,130 @@
+/**
+ * @file Arduino.h
+ * @brief A minimal host-side mock of the Arduino core, covering exactly the pieces
+ * the SDI-12 library touches.
+ *
+ * The mock keeps a virtual clock (advanced only by delay()/delayMicroseconds()),
+ * per-pin levels, and per-pin attached interrupt functions, all exposed through the
+ * ::sdi12mock namespace so tests - and the virtual bus driver - can manipulate them
+ * directly.  Nothing here is compiled into the library for a real board.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+// Flash-memory storage resolves to plain memory on the host
+#define PROGMEM
+typedef const char* PGM_P;
+#define pgm_read_byte(addr) (*(reinterpret_cast<const uint8_t*>(addr)))
+#define pgm_read_word(addr) (*(reinterpret_cast<const uint16_t*>(addr)))
+#define strlen_P strlen
+#define strncpy_P strncpy
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper*>(string_literal))
+#define FPSTR(p) (reinterpret_cast<const __FlashStringHelper*>(p))
+
+unsigned long micros();
+unsigned long millis();
+void          delay(unsigned long ms);
+void          delayMicroseconds(unsigned int us);
+void          pinMode(uint8_t pin, uint8_t mode);
+void          digitalWrite(uint8_t pin, uint8_t val);
+int           digitalRead(uint8_t pin);
+void          interrupts();
+void          noInterrupts();
+void          yield();
+
+typedef void (*voidFuncPtr)(void);
+void attachInterrupt(uint8_t interruptNum, voidFuncPtr userFunc, int mode);
+void detachInterrupt(uint8_t interruptNum);
+#define digitalPinToInterrupt(p) (p)
+
+/// A pared-down Arduino String backed by std::string - just the operations the
+/// library and its tests use.
+class String {
+ public:
+  String() {}
+  String(const char* cstr) : _s(cstr ? cstr : "") {}          // NOLINT
+  String(char c) : _s(1, c) {}                                // NOLINT
+  String(const std::string& s) : _s(s) {}                     // NOLINT
+  String(int value) : _s(std::to_string(value)) {}            // NOLINT
+  String(unsigned int value) : _s(std::to_string(value)) {}   // NOLINT
+  String(long value) : _s(std::to_string(value)) {}           // NOLINT
+  String(unsigned long value) : _s(std::to_string(value)) {}  // NOLINT
+  String(const __FlashStringHelper* f)                        // NOLINT
+    : _s(reinterpret_cast<const char*>(f)) {}
+
+  const char*  c_str() const { return _s.c_str(); }
+  unsigned int length() const { return static_cast<unsigned int>(_s.length()); }
+  char         operator[](unsigned int i) const { return _s[i]; }
+  char&        operator[](unsigned int i) { return _s[i]; }
+  String&      operator+=(const String& rhs) {
+    _s += rhs._s;
+    return *this;
+  }
+  String& operator+=(char c) {
+    _s += c;
+    return *this;
+  }
+  String& operator+=(const char* rhs) {
+    _s += rhs;
+    return *this;
+  }
+  friend String operator+(String lhs, const String& rhs) {
+    lhs += rhs;
+    return lhs;
+  }
+  bool operator==(const String& rhs) const { return _s == rhs._s; }
+  bool operator!=(const String& rhs) const { return _s != rhs._s; }
+  void trim() {
+    while (!_s.empty() && isspace(static_cast<unsigned char>(_s.back())))
+      _s.pop_back();
+    size_t start = 0;
+    while (start < _s.size() && isspace(static_cast<unsigned char>(_s[start]))) start++;
+    _s.erase(0, start);
+  }
+  char charAt(unsigned int i) const { return _s[i]; }
+  int  indexOf(char c) const {
+    size_t pos = _s.find(c);
+    return pos == std::string::npos ? -1 : static_cast<int>(pos);
+  }
+  String substring(unsigned int from) const { return String(_s.substr(from)); }
+  String substring(unsigned int from, unsigned int to) const {
+    return String(_s.substr(from, to - from));
+  }
+  long  toInt() const { return atol(_s.c_str()); }
+  float toFloat() const { return static_cast<float>(atof(_s.c_str())); }
+
+ private:
+  std::string _s;
+};
+
+#include "Stream.h"
+
+/// Hooks into the mock's state, for tests and the virtual bus driver.
+namespace sdi12mock {
+/// The mock clock, in microseconds.  micros()/millis() read it; only
+/// delay()/delayMicroseconds() - and the virtual bus replaying a trace - advance it.
+extern unsigned long mockMicros;
+/// The current level of each digital pin, as seen by digitalRead().
+extern int pinLevel[64];
+/// The interrupt function attached to each pin, if any.
+extern voidFuncPtr pinIsr[64];
+}  // namespace sdi12mock
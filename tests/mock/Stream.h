@@ -0,0 +1,91 @@
+/**
+ * @file Stream.h
+ * @brief A minimal host-side mock of the Arduino Stream/Print classes - just enough
+ * for the SDI-12 library's Stream inheritance and the tests' reads.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+class String;
+
+enum LookaheadMode { SKIP_ALL, SKIP_NONE, SKIP_WHITESPACE };
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+  }
+  size_t print(const char* str) {
+    return write(reinterpret_cast<const uint8_t*>(str), strlen(str));
+  }
+  size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+  size_t println(const char* str) {
+    size_t n = print(str);
+    n += print("\r\n");
+    return n;
+  }
+};
+
+unsigned long millis();
+
+class Stream : public Print {
+ protected:
+  unsigned long _timeout = 1000;
+  unsigned long _startMillis;
+
+  int timedRead() {
+    _startMillis = millis();
+    do {
+      int c = read();
+      if (c >= 0) return c;
+    } while (millis() - _startMillis < _timeout);
+    return -1;
+  }
+  int timedPeek() {
+    _startMillis = millis();
+    do {
+      int c = peek();
+      if (c >= 0) return c;
+    } while (millis() - _startMillis < _timeout);
+    return -1;
+  }
+
+ public:
+  virtual int  available() = 0;
+  virtual int  read()      = 0;
+  virtual int  peek()      = 0;
+  virtual void flush() {}
+
+  void          setTimeout(unsigned long timeout) { _timeout = timeout; }
+  unsigned long getTimeout() { return _timeout; }
+
+  size_t readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+      int c = timedRead();
+      if (c < 0) break;
+      *buffer++ = static_cast<char>(c);
+      count++;
+    }
+    return count;
+  }
+  size_t readBytes(uint8_t* buffer, size_t length) {
+    return readBytes(reinterpret_cast<char*>(buffer), length);
+  }
+  size_t readBytesUntil(char terminator, char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+      int c = timedRead();
+      if (c < 0 || c == terminator) break;
+      *buffer++ = static_cast<char>(c);
+      count++;
+    }
+    return count;
+  }
+};
@@ -0,0 +1,40 @@
+/**
+ * @file mock_core.cpp
+ * @brief Host-side implementations for the Arduino core mock.
+ */
+#include "Arduino.h"
+
+namespace sdi12mock {
+unsigned long mockMicros = 0;
+int           pinLevel[64];
+voidFuncPtr   pinIsr[64];
+}  // namespace sdi12mock
+
+unsigned long micros() {
+  return sdi12mock::mockMicros;
+}
+unsigned long millis() {
+  return sdi12mock::mockMicros / 1000UL;
+}
+void delay(unsigned long ms) {
+  sdi12mock::mockMicros += ms * 1000UL;
+}
+void delayMicroseconds(unsigned int us) {
+  sdi12mock::mockMicros += us;
+}
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t pin, uint8_t val) {
+  sdi12mock::pinLevel[pin] = val;
+}
+int digitalRead(uint8_t pin) {
+  return sdi12mock::pinLevel[pin];
+}
+void interrupts() {}
+void noInterrupts() {}
+void yield() {}
+void attachInterrupt(uint8_t interruptNum, voidFuncPtr userFunc, int) {
+  sdi12mock::pinIsr[interruptNum] = userFunc;
+}
+void detachInterrupt(uint8_t interruptNum) {
+  sdi12mock::pinIsr[interruptNum] = nullptr;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file test_decode.cpp
+ * @brief Regression tests for the receive interrupt's bit-reconstruction logic,
+ * driven by edge-timestamp traces through the virtual bus.
+ *
+ * These cover the decoding edge cases that are hardest to hit on hardware and the
+ * first to regress when the interrupt is optimized: characters whose trailing bits
+ * never produce an edge (flushed by the next start bit via the `nextCharStarted`
+ * inference), the all-marking DEL character, parity rejection, long idle gaps
+ * between characters, and interrupt-latency jitter on every edge.
+ */
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Arduino.h"
+#include "SDI12.h"
+#include "SDI12VirtualBus.h"
+
+/// Drain the decoded characters and compare them against an expected string.
+static void expectRead(SDI12& s, const char* expected) {
+  for (const char* p = expected; *p; p++) {
+    int c = s.read();
+    if (c != *p) {
+      printf("FAIL: expected '%c' (0x%02x), read %d\n", *p, *p, c);
+      assert(false);
+    }
+  }
+  if (s.available() != 0) {
+    printf("FAIL: after '%s', %d unread chars:", expected, s.available());
+    while (s.available()) { printf(" 0x%02x", s.read()); }
+    printf("\n");
+    assert(false);
+  }
+}
+
+int main() {
+  SDI12 s(7);
+  s.begin();
+  s.forceListen();
+  SDI12VirtualBus vb(7);
+
+  // A clean, spec-conforming response decodes character for character
+  vb.addMarking(10000);
+  vb.addString("0+1.50-2.25\r\n");
+  vb.replay();
+  assert(s.messageAvailable());
+  expectRead(s, "0+1.50-2.25\r\n");
+
+  // DEL (0x7F): every info bit is marking, so the only edges are the start bit's
+  // rise and fall - the rest of the character must be inferred when the next
+  // character's start bit arrives
+  s.clearBuffer();
+  vb.reset(vb.cursor() + 20000);
+  vb.addChar(0x7F);
+  vb.addString("A\r\n");
+  vb.replay();
+  expectRead(s, "\x7F"
+               "A\r\n");
+
+  // A character with a wrong parity bit poisons the response: it and everything
+  // after it are discarded (the parity flag holds until the next command), so a
+  // corrupted response can never be mistaken for a shorter valid one
+  s.clearBuffer();
+  vb.reset(vb.cursor() + 20000);
+  vb.addChar('1');
+  vb.addCharBadParity('Q');
+  vb.addString("3\r\n");
+  vb.replay();
+  expectRead(s, "1");
+  // a new command (state change to transmitting) clears the parity failure
+  s.sendCommand("");
+  s.clearBuffer();
+
+  // Long marking gaps between characters (a slow sensor pausing mid-response, far
+  // past a timer rollover on small counters) do not desynchronize the decoder
+  s.clearBuffer();
+  vb.reset(vb.cursor() + 20000);
+  vb.addChar('7');
+  vb.addMarking(50000);
+  vb.addChar('+');
+  vb.addMarking(200000);
+  vb.addString("9\r\n");
+  vb.replay();
+  expectRead(s, "7+9\r\n");
+
+  // Alternating +-40us edge displacement - the worst-case scatter RX_WINDOW_FUDGE
+  // is sized to absorb (fudge covers ~95us of one-sided latency; alternating
+  // displacement doubles into the inter-edge delta) - still lands every edge in
+  // the right bit slot
+  s.clearBuffer();
+  vb.reset(vb.cursor() + 20000);
+  vb.setJitter(40);
+  vb.addString("z+0.123+45.6\r\n");
+  vb.replay();
+  expectRead(s, "z+0.123+45.6\r\n");
+  vb.setJitter(0);
+
+  // The full printable ASCII range survives a round trip
+  s.clearBuffer();
+  vb.reset(vb.cursor() + 20000);
+  char all[98];
+  int  n = 0;
+  for (char c = ' '; c <= '~'; c++) { all[n++] = c; }
+  all[n++] = '\r';
+  all[n++] = '\n';
+  all[n]   = '\0';
+  vb.addString(all);
+  vb.replay();
+  expectRead(s, all);
+
+  // Bulk accessors: readBytes() drains in at most two memcpys across the ring's
+  // wrap point, and peekContiguous()/skipBytes() expose the same data in place
+  s.clearBuffer();  // head and tail back to 0
+  vb.reset(vb.cursor() + 20000);
+  vb.addString(all);  // 97 characters
+  vb.replay();
+  uint8_t bulk[128];
+  assert(s.readBytes(bulk, 90) == 90);
+  assert(memcmp(bulk, all, 90) == 0);
+  // head is now 90 of 128; 42 more characters wrap the tail past the boundary
+  vb.reset(vb.cursor() + 20000);
+  vb.addString("0123456789012345678901234567890123456789\r\n");
+  vb.replay();
+  assert(s.available() == 49);  // 7 leftover + 42 new
+  const uint8_t* seg = nullptr;
+  assert(s.peekContiguous(&seg) == 38);  // only 38 are contiguous before the wrap
+  assert(seg != nullptr && seg[0] == static_cast<uint8_t>(all[90]));
+  assert(s.skipBytes(38) == 38);
+  assert(s.peekContiguous(&seg) == 11);  // the wrapped remainder
+  assert(s.readBytes(bulk, sizeof(bulk)) == 11);
+  assert(bulk[9] == '\r' && bulk[10] == '\n');
+  assert(s.available() == 0);
+  assert(s.peekContiguous(&seg) == 0 && seg == nullptr);
+
+  printf("test_decode: all assertions passed\n");
+  return 0;
+}
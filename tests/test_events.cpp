@@ -0,0 +1,88 @@
+/**
+ * @file test_events.cpp
+ * @brief Tests for the SDI12_LINE_EVENTS classification stage: break recognition,
+ * post-break marking completion, idle detection (retroactive flag and live poll),
+ * the read-and-clear event accessor, and the interrupt-context callback.
+ *
+ * Built with SDI12_LINE_EVENTS (see CMakeLists.txt).
+ */
+#include <assert.h>
+#include <stdio.h>
+
+#include "Arduino.h"
+#include "SDI12.h"
+#include "SDI12VirtualBus.h"
+
+static uint8_t  cbEvents = 0;
+static uint32_t cbCalls  = 0;
+static void     onLineEvent(uint8_t events) {
+  cbEvents |= events;
+  cbCalls++;
+}
+
+int main() {
+  SDI12 s(7);
+  s.begin();
+  s.forceListen();
+  s.setLineEventHandler(onLineEvent);
+  SDI12VirtualBus vb(7);
+
+  // A full wake sequence: the cold line raises IDLE at its first edge, the falling
+  // edge after 12.1 ms of spacing raises BREAK, and the first start bit after
+  // 8.4 ms of marking raises MARKING - while the command still decodes normally
+  vb.addMarking(10000);
+  vb.addBreak();  // 12.1 ms break, 8.4 ms marking
+  vb.addString("0!\r\n");
+  vb.replay();
+  uint8_t events = s.pollLineEvents();
+  assert(events & SDI12_LINE_EVENT_IDLE);
+  assert(events & SDI12_LINE_EVENT_BREAK);
+  assert(events & SDI12_LINE_EVENT_MARKING);
+  assert(s.pollLineEvents() == 0);  // the poll cleared the pending set
+  assert(s.lastBreakTime() > 0);
+  assert(s.lastMarkingTime() >= s.lastBreakTime());
+  // Decoding is not disturbed: the break span still deposits the NUL character a
+  // listening decoder has always produced for it, followed by the command
+  assert(s.available() == 5);
+  assert(s.read() == 0x00);
+  assert(s.read() == '0');
+
+  // Ordinary traffic raises nothing: within characters the longest spacing run is
+  // ~9 bit times, and a 20 ms gap is neither a break (wrong level) nor idle
+  s.clearBuffer();
+  vb.reset(vb.cursor() + 20000);
+  vb.addMarking(5000);
+  vb.addString("abc\r\n");
+  vb.replay();
+  assert(s.pollLineEvents() == 0);
+
+  // A break whose marking period is cut short never completes the wake sequence
+  s.clearBuffer();
+  vb.reset(vb.cursor() + 20000);
+  vb.addBreak(12100, 3000);  // only 3 ms of marking before the first character
+  vb.addString("x\r\n");
+  vb.replay();
+  events = s.pollLineEvents();
+  assert(events & SDI12_LINE_EVENT_BREAK);
+  assert(!(events & SDI12_LINE_EVENT_MARKING));
+
+  // Idle: the live poll goes true once the line has been quiet past the threshold,
+  // and the flag is raised retroactively by the next edge
+  s.clearBuffer();
+  delay(200);  // 200 ms of silence
+  assert(s.lineIdle());
+  vb.reset(vb.cursor() + 500000);
+  vb.addChar('y');
+  vb.replay();
+  events = s.pollLineEvents();
+  assert(events & SDI12_LINE_EVENT_IDLE);
+  assert(!s.lineIdle());  // an edge was just seen
+
+  // the callback saw every classification as it happened
+  assert(cbCalls >= 4);
+  assert(cbEvents ==
+         (SDI12_LINE_EVENT_IDLE | SDI12_LINE_EVENT_BREAK | SDI12_LINE_EVENT_MARKING));
+
+  printf("test_events: all assertions passed\n");
+  return 0;
+}
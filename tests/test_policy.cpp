@@ -0,0 +1,75 @@
+/**
+ * @file test_policy.cpp
+ * @brief Verifies the SDI12TimerPolicy specializations against the hand-tuned
+ * values of the historical macro cascade, and the bitTimes() arithmetic - in
+ * particular the deliberate uint8_t wrap on the 8-bit counter configurations.
+ *
+ * Because the policies are templates, every board's timing math is checkable on the
+ * host without that board's timer registers - including the 31250-tick/8-bit AVR
+ * configuration whose counter rolls over within a single character.
+ */
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Arduino.h"
+#include "SDI12_boards.h"
+
+// (tick rate, counter size) -> TICKS_PER_BIT, BITS_PER_TICK_Q10, RX_WINDOW_FUDGE,
+// exactly as the macro cascade defined them per board
+static_assert(SDI12TimerPolicy<15625, 8>::ticksPerBit == 13, "");
+static_assert(SDI12TimerPolicy<15625, 8>::bitsPerTickQ10 == 79, "");
+static_assert(SDI12TimerPolicy<15625, 8>::rxWindowFudge == 2, "");
+static_assert(!SDI12TimerPolicy<15625, 8>::rollsOverWithinChar, "");
+static_assert(SDI12TimerPolicy<11719, 8>::ticksPerBit == 10, "");
+static_assert(SDI12TimerPolicy<11719, 8>::bitsPerTickQ10 == 105, "");
+static_assert(SDI12TimerPolicy<31250, 8>::ticksPerBit == 26, "");
+static_assert(SDI12TimerPolicy<31250, 8>::bitsPerTickQ10 == 39, "");
+static_assert(SDI12TimerPolicy<31250, 8>::rxWindowFudge == 10, "");
+static_assert(SDI12TimerPolicy<31250, 8>::rollsOverWithinChar, "");
+static_assert(SDI12TimerPolicy<62500, 16>::ticksPerBit == 52, "");
+static_assert(SDI12TimerPolicy<46875, 16>::ticksPerBit == 39, "");
+static_assert(SDI12TimerPolicy<31250, 16>::ticksPerBit == 26, "");
+static_assert(!SDI12TimerPolicy<31250, 16>::rollsOverWithinChar, "");
+static_assert(SDI12TimerPolicy<500000, 16>::ticksPerBit == 416, "");
+static_assert(SDI12TimerPolicy<500000, 16>::rxWindowFudge == 30, "");
+static_assert(SDI12TimerPolicy<1000000, 32>::ticksPerBit == 833, "");
+// the host harness compiles with F_CPU=48000000L, which selects the larger fudge
+static_assert(SDI12TimerPolicy<1000000, 32>::rxWindowFudge == 95, "");
+
+// counter types match the hardware registers
+static_assert(sizeof(SDI12TimerPolicy<31250, 8>::counter_t) == 1, "");
+static_assert(sizeof(SDI12TimerPolicy<62500, 16>::counter_t) == 2, "");
+static_assert(sizeof(sdi12timer_t) == 4, "");  // the host build uses micros()
+
+int main() {
+  // bitTimes() parity with the historical mul8x8to16 Q10 implementation on the
+  // 8-bit configurations, including the fudge being added *inside* the uint8_t wrap
+  typedef SDI12TimerPolicy<15625, 8> Mayfly;
+  for (unsigned dt = 0; dt < 256; dt++) {
+    uint16_t expected = static_cast<uint16_t>(
+                          static_cast<uint8_t>(dt + Mayfly::rxWindowFudge) *
+                          static_cast<uint16_t>(Mayfly::bitsPerTickQ10)) >>
+      10;
+    assert(Mayfly::bitTimes(static_cast<uint8_t>(dt)) == expected);
+  }
+
+  // one bit and one character's worth of ticks land on the right counts
+  assert(Mayfly::bitTimes(13) == 1);
+  assert((SDI12TimerPolicy<1000000, 32>::bitTimes(833)) == 1);
+  assert((SDI12TimerPolicy<1000000, 32>::bitTimes(8333)) == 10);
+  assert((SDI12TimerPolicy<62500, 16>::bitTimes(52 * 9)) == 9);
+
+  // on the rollover config, a delta measured across the counter wrap still lands
+  // on the right bit count: prev = 250, now = 20 wraps to a delta of 26 ticks = 1
+  // bit time
+  typedef SDI12TimerPolicy<31250, 8> Rollover;
+  uint8_t                            prev = 250;
+  uint8_t                            now  = 20;
+  assert(Rollover::bitTimes(static_cast<uint8_t>(now - prev)) == 1);
+  // and the policy flags the hazard so the ISR skips the sub-bit-spacing check
+  assert(Rollover::bitsPerRollover < 10);
+
+  printf("test_policy: all assertions passed\n");
+  return 0;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file SDI12VirtualBus.cpp
+ * @brief Implementation of the virtual SDI-12 bus trace builder and replayer.
+ */
+#include "SDI12VirtualBus.h"
+
+#include <algorithm>
+
+#include "Arduino.h"
+#include "SDI12.h"
+
+SDI12VirtualBus::SDI12VirtualBus(int8_t pin, uint32_t startMicros) : _pin(pin) {
+  reset(startMicros);
+}
+
+void SDI12VirtualBus::reset(uint32_t startMicros) {
+  _edges.clear();
+  _glitches.clear();
+  _cursor     = startMicros;
+  _level      = LOW;  // idle line is marking
+  _jitterSign = false;
+}
+
+void SDI12VirtualBus::addChar(uint8_t c) {
+  uint8_t data = c & 0x7F;
+  // __builtin_parity is 1 for an odd number of set bits, which is exactly the even
+  // parity bit's value
+  uint8_t parity = static_cast<uint8_t>(__builtin_parity(data));
+  addFrame(static_cast<uint8_t>(data | (parity << 7)));
+}
+
+void SDI12VirtualBus::addCharBadParity(uint8_t c) {
+  uint8_t data   = c & 0x7F;
+  uint8_t parity = static_cast<uint8_t>(__builtin_parity(data) ^ 0x01);
+  addFrame(static_cast<uint8_t>(data | (parity << 7)));
+}
+
+void SDI12VirtualBus::addString(const char* s) {
+  for (const char* p = s; *p; p++) { addChar(static_cast<uint8_t>(*p)); }
+}
+
+void SDI12VirtualBus::addFrame(uint8_t infoBits) {
+  // inverse logic: the start bit is spacing (HIGH), a 1 info bit is marking (LOW),
+  // and the stop bit is marking (LOW)
+  for (uint8_t slot = 0; slot < 10; slot++) {
+    uint8_t level;
+    if (slot == 0) {
+      level = HIGH;
+    } else if (slot <= 8) {
+      level = ((infoBits >> (slot - 1)) & 0x01) ? LOW : HIGH;
+    } else {
+      level = LOW;
+    }
+    if (level != _level) {
+      emitEdge(_cursor + bitOffset(slot), level);
+      _level = level;
+    }
+  }
+  _cursor += bitOffset(10);
+}
+
+void SDI12VirtualBus::addMarking(uint32_t durationMicros) {
+  _cursor += durationMicros;  // marking is the idle level; no edges
+}
+
+void SDI12VirtualBus::addBreak(uint32_t breakMicros, uint32_t markMicros) {
+  emitEdge(_cursor, HIGH);  // continuous spacing
+  _cursor += breakMicros;
+  emitEdge(_cursor, LOW);  // back to marking
+  _cursor += markMicros;
+  _level = LOW;
+}
+
+void SDI12VirtualBus::addEdge(uint32_t atMicros, uint8_t level) {
+  _edges.push_back({atMicros, level});
+  if (atMicros >= _cursor) {
+    _cursor = atMicros;
+    _level  = level;
+  }
+}
+
+void SDI12VirtualBus::addGlitch(uint32_t atMicros, uint32_t widthMicros) {
+  _glitches.push_back({atMicros, widthMicros});
+}
+
+void SDI12VirtualBus::setJitter(uint32_t plusMinusMicros) {
+  _jitter = plusMinusMicros;
+}
+
+void SDI12VirtualBus::emitEdge(uint32_t t, uint8_t level) {
+  if (_jitter != 0) {
+    t           = _jitterSign ? t + _jitter : t - _jitter;
+    _jitterSign = !_jitterSign;
+  }
+  _edges.push_back({t, level});
+}
+
+uint8_t SDI12VirtualBus::levelAt(uint32_t t) const {
+  uint8_t level = LOW;
+  for (const Edge& e : _edges) {
+    if (e.t > t) { break; }
+    level = e.level;
+  }
+  return level;
+}
+
+void SDI12VirtualBus::replay() {
+  // merge the noise pulses into the scheduled edges with the levels they would
+  // really produce on the line at that instant
+  std::vector<Edge> all = _edges;
+  for (const Glitch& g : _glitches) {
+    uint8_t lvl = levelAt(g.t);
+    all.push_back({g.t, static_cast<uint8_t>(lvl == HIGH ? LOW : HIGH)});
+    all.push_back({g.t + g.width, lvl});
+  }
+  std::stable_sort(all.begin(), all.end(),
+                   [](const Edge& a, const Edge& b) { return a.t < b.t; });
+
+  for (const Edge& e : all) {
+    sdi12mock::mockMicros = e.t;
+    if (sdi12mock::pinLevel[_pin] == e.level) { continue; }  // not a transition
+    sdi12mock::pinLevel[_pin] = e.level;
+    SDI12::handleInterrupt();
+  }
+}
@@ -0,0 +1,105 @@
+/**
+ * @file SDI12VirtualBus.h
+ * @brief A virtual SDI-12 bus for the host-side tests: builds edge-timestamp traces
+ * and replays them through SDI12::handleInterrupt().
+ *
+ * The driver frames characters independently of the library - its own start bit,
+ * LSB-first inverted data, even parity, stop bit - so a decoding bug cannot be
+ * masked by the encoder sharing the same mistake.  Traces are built from characters,
+ * marking gaps, breaks, raw edges, and injected noise pulses; deterministic timing
+ * jitter can be layered on every edge.  replay() then walks the trace in time order,
+ * setting the mock clock and pin level for each edge before invoking the library's
+ * interrupt handler - exactly the stimulus a real pin-change interrupt delivers,
+ * with exactly reproducible timing.
+ */
+#ifndef SRC_SDI12VIRTUALBUS_H_
+#define SRC_SDI12VIRTUALBUS_H_
+
+#include <stdint.h>
+#include <vector>
+
+class SDI12;
+
+class SDI12VirtualBus {
+ public:
+  /**
+   * @brief Construct a virtual bus driving one data pin.
+   *
+   * @param pin The mock pin the SDI12 object under test is attached to.
+   * @param startMicros Where on the mock clock the trace begins; the line is at
+   * marking (LOW) before it.
+   */
+  explicit SDI12VirtualBus(int8_t pin, uint32_t startMicros = 100000);
+
+  /// Discard the trace and rewind the cursor.
+  void reset(uint32_t startMicros = 100000);
+
+  /// Append one 7E1-framed character (10 bit times) at the cursor.
+  void addChar(uint8_t c);
+  /// Append every character of a null-terminated string, back to back.
+  void addString(const char* s);
+  /// Append one character framed with a deliberately wrong parity bit.
+  void addCharBadParity(uint8_t c);
+  /// Advance the cursor with the line held at marking (no edges).
+  void addMarking(uint32_t durationMicros);
+  /// Append a wake break (continuous spacing) followed by the required marking.
+  void addBreak(uint32_t breakMicros = 12100, uint32_t markMicros = 8400);
+  /// Append a raw edge at an absolute trace time, for hand-built traces.
+  void addEdge(uint32_t atMicros, uint8_t level);
+  /**
+   * @brief Inject a noise pulse: the line inverts at `atMicros` (whatever its
+   * scheduled level there is) and reverts `widthMicros` later.
+   */
+  void addGlitch(uint32_t atMicros, uint32_t widthMicros);
+  /**
+   * @brief Apply deterministic timing jitter: each subsequent framed edge is
+   * displaced by +jitter, then -jitter, alternating.  Models interrupt-latency
+   * scatter without non-reproducible randomness.
+   */
+  void setJitter(uint32_t plusMinusMicros);
+
+  /// The current cursor position on the mock clock, in microseconds.
+  uint32_t cursor() const { return _cursor; }
+
+  /**
+   * @brief Replay the trace through the library's interrupt handler.
+   *
+   * Edges (including injected glitches, merged in time order) are applied one at a
+   * time: the mock clock jumps to the edge's timestamp, the pin level changes, and
+   * SDI12::handleInterrupt() runs.  The object under test must already be
+   * listening (begin() + forceListen()).  The trace is kept, so it can be replayed
+   * against several configurations.
+   */
+  void replay();
+
+ private:
+  struct Edge {
+    uint32_t t;
+    uint8_t  level;
+  };
+  struct Glitch {
+    uint32_t t;
+    uint32_t width;
+  };
+
+  /// Append the 10 line levels of one frame: start bit + 8 info bits + stop bit.
+  void addFrame(uint8_t infoBits);
+  /// Record an edge at `t`, displaced by the alternating jitter.
+  void emitEdge(uint32_t t, uint8_t level);
+  /// The scheduled line level at an instant, ignoring glitches.
+  uint8_t levelAt(uint32_t t) const;
+  /// The ideal offset of a bit slot boundary from the start of its frame.
+  static uint32_t bitOffset(uint8_t slot) {
+    return (static_cast<uint32_t>(slot) * 10000UL) / 12;  // 833.33 us per bit
+  }
+
+  std::vector<Edge>   _edges;
+  std::vector<Glitch> _glitches;
+  int8_t              _pin;
+  uint32_t            _cursor;
+  uint8_t             _level;  // the line level at the cursor
+  uint32_t            _jitter     = 0;
+  bool                _jitterSign = false;
+};
+
+#endif  // SRC_SDI12VIRTUALBUS_H_